@@ -0,0 +1,317 @@
+/**
+ * Decoder and printer throughput on synthetic instruction streams.
+ * Streams are generated from the tables built out of scripts/instructions.txt
+ * with a fixed seed, so every run and every build sees the same bytes.
+ *
+ * Usage: decode_bench [size_mb] [repetitions] [threads]
+ */
+#include "decoder.h"
+#include "instructions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_RDTSC 1
+#endif
+
+namespace {
+
+std::atomic<std::size_t> alloc_count = 0;
+
+} // namespace
+
+void *operator new(std::size_t size) {
+	++alloc_count;
+	if (void *ptr = std::malloc(size ? size : 1)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace {
+
+using namespace emu8086;
+using Clock = std::chrono::steady_clock;
+
+uint64_t read_tsc() {
+#ifdef HAS_RDTSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+enum class Mix {
+	Register, // no memory operands, ModRM always mod=11
+	ModRM, // only opcodes with a ModRM byte, always a memory form
+	Prefix, // uniform instructions behind 1-3 segment/lock/rep prefixes
+	Jump, // half short jumps and loops, half uniform
+	Uniform, // every valid opcode with the same probability
+};
+
+constexpr const char *mix_names[] = { "register", "modrm", "prefix", "jump", "uniform" };
+
+struct Opcodes {
+	std::vector<uint8_t> all;
+	std::vector<uint8_t> reg;
+	std::vector<uint8_t> modrm;
+	std::vector<uint8_t> jump;
+	std::vector<uint8_t> prefix;
+};
+
+bool is_group(uint8_t opcode) {
+	return instructions[opcode].__special_instr_idx >= 0;
+}
+
+bool group_entry_known(uint8_t opcode, uint8_t reg) {
+	return special_instructions[instructions[opcode].__special_instr_idx][reg].type != InstructionType::Unknown;
+}
+
+Opcodes collect_opcodes() {
+	Opcodes res;
+	for (int i = 0; i < 256; ++i) {
+		const uint8_t opcode = static_cast<uint8_t>(i);
+		const Instruction &instr = instructions[opcode];
+		if (instr_lengths[opcode].flags & LENGTH_PREFIX) {
+			res.prefix.push_back(opcode);
+			continue;
+		}
+		if (instr.type == InstructionType::Unknown) {
+			continue;
+		}
+
+		res.all.push_back(opcode);
+
+		const bool has_modrm = instr_lengths[opcode].flags & LENGTH_MODRM;
+		if (has_modrm) {
+			res.modrm.push_back(opcode);
+		}
+
+		switch (instr.type) {
+		case InstructionType::Jmp:
+			res.jump.push_back(opcode);
+			break;
+		case InstructionType::Acc_Mem:
+		case InstructionType::Mem_Acc:
+		case InstructionType::StringManip:
+		case InstructionType::NearProc:
+		case InstructionType::FarProc:
+		case InstructionType::RegMem_Far:
+			break;
+		default:
+			res.reg.push_back(opcode);
+			break;
+		}
+	}
+
+	return res;
+}
+
+/**
+ * Appends one instruction starting with opcode. ModRM is random unless
+ * register_only, when it is forced to mod=11, or memory_only, when mod is 0-2.
+ */
+void emit_instr(std::vector<uint8_t> &out, std::mt19937_64 &rng, uint8_t opcode, bool register_only, bool memory_only) {
+	const InstrLength info = instr_lengths[opcode];
+
+	uint8_t modrm = static_cast<uint8_t>(rng());
+	if (register_only) {
+		modrm |= 0xc0;
+	}
+	if (memory_only) {
+		modrm = static_cast<uint8_t>(modrm % 0xc0);
+	}
+	if (is_group(opcode)) {
+		while (!group_entry_known(opcode, (modrm & SB_REG_MASK) >> 3)) {
+			modrm = static_cast<uint8_t>((modrm & ~SB_REG_MASK) | ((rng() << 3) & SB_REG_MASK));
+		}
+	}
+
+	std::size_t size = info.size;
+	if (info.flags & LENGTH_MODRM) {
+		size += modrm_table[modrm].disp_size;
+	}
+	if ((info.flags & LENGTH_GROUP_IMM) && (modrm & SB_REG_MASK) == 0) {
+		size += 1 + (opcode & W_MASK);
+	}
+
+	out.push_back(opcode);
+	if (size > 1) {
+		out.push_back(modrm);
+	}
+	for (std::size_t i = 2; i < size; ++i) {
+		out.push_back(static_cast<uint8_t>(rng()));
+	}
+}
+
+template<typename T>
+T pick(const std::vector<T> &items, std::mt19937_64 &rng) {
+	return items[rng() % items.size()];
+}
+
+std::vector<uint8_t> generate(Mix mix, std::size_t size, const Opcodes &opcodes) {
+	std::mt19937_64 rng(0x8086 + static_cast<int>(mix));
+
+	std::vector<uint8_t> out;
+	out.reserve(size + 16);
+	while (out.size() < size) {
+		switch (mix) {
+		case Mix::Register:
+			emit_instr(out, rng, pick(opcodes.reg, rng), true, false);
+			break;
+		case Mix::ModRM:
+			emit_instr(out, rng, pick(opcodes.modrm, rng), false, true);
+			break;
+		case Mix::Prefix:
+			for (uint64_t i = 0, n = 1 + rng() % 3; i < n; ++i) {
+				out.push_back(pick(opcodes.prefix, rng));
+			}
+			emit_instr(out, rng, pick(opcodes.all, rng), false, false);
+			break;
+		case Mix::Jump:
+			emit_instr(out, rng, pick(rng() & 1 ? opcodes.jump : opcodes.all, rng), false, false);
+			break;
+		case Mix::Uniform:
+			emit_instr(out, rng, pick(opcodes.all, rng), false, false);
+			break;
+		}
+	}
+
+	return out;
+}
+
+struct Measurement {
+	double seconds = 1e9;
+	uint64_t cycles = ~uint64_t(0);
+	std::size_t allocs = 0;
+};
+
+template<typename F>
+Measurement measure(int repetitions, F &&f) {
+	Measurement best;
+	for (int r = 0; r < repetitions; ++r) {
+		const std::size_t allocs_before = alloc_count;
+		const auto start = Clock::now();
+		const uint64_t tsc_start = read_tsc();
+
+		f();
+
+		const uint64_t tsc_end = read_tsc();
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		if (seconds < best.seconds) {
+			best.seconds = seconds;
+			best.cycles = tsc_end - tsc_start;
+			best.allocs = alloc_count - allocs_before;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * @breif Parses a positive decimal argument no larger than max.
+ */
+bool parse_count(const char *arg, long max, long &value) {
+	char *end = nullptr;
+	errno = 0;
+	value = std::strtol(arg, &end, 10);
+	return end != arg && *end == '\0' && errno == 0 && value > 0 && value <= max;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	long size_arg = 4;
+	long repetitions_arg = 10;
+	long threads_arg = 1;
+	if ((argc > 1 && !parse_count(argv[1], 4096, size_arg))
+		|| (argc > 2 && !parse_count(argv[2], INT_MAX, repetitions_arg))
+		|| (argc > 3 && !parse_count(argv[3], 1024, threads_arg))) {
+		fprintf(stderr, "Usage: decode_bench [size_mb] [repetitions] [threads]\n");
+		return 1;
+	}
+	const std::size_t size_mb = static_cast<std::size_t>(size_arg);
+	const int repetitions = static_cast<int>(repetitions_arg);
+	const unsigned threads = static_cast<unsigned>(threads_arg);
+
+#ifdef _WIN32
+	FILE *null_out = fopen("NUL", "wb");
+#else
+	FILE *null_out = fopen("/dev/null", "wb");
+#endif
+	if (!null_out) {
+		fprintf(stderr, "Failed to open null output!\n");
+		return 1;
+	}
+
+	const Opcodes opcodes = collect_opcodes();
+
+	fprintf(stdout, "%zu MB per mix, best of %d, %u thread(s)%s\n", size_mb, repetitions, threads,
+#ifdef HAS_RDTSC
+		""
+#else
+		", no rdtsc on this target"
+#endif
+	);
+	fprintf(stdout, "%-9s %10s %10s %9s %9s %11s | %10s %10s %9s\n",
+		"mix", "instrs", "MB/s", "Minstr/s", "cyc/inst", "allocs", "print MB/s", "cyc/inst", "allocs");
+
+	for (int m = 0; m < 5; ++m) {
+		const Mix mix = static_cast<Mix>(m);
+		std::vector<uint8_t> stream = generate(mix, size_mb * 1024 * 1024, opcodes);
+		const std::size_t stream_size = stream.size();
+		stream.resize(stream_size + DECODE_PADDING);
+
+		std::size_t instr_count = 0;
+		bool ok = true;
+		const Measurement decode = measure(repetitions, [&]() {
+			Decoder decoder;
+			ok = decoder.decode(stream.data(), stream_size, threads) && ok;
+			instr_count = decoder.instructions().size();
+		});
+
+		Decoder decoder;
+		decoder.decode(stream.data(), stream_size, threads);
+		const Measurement print = measure(repetitions, [&]() {
+			decoder.print_asm(null_out, threads);
+			fflush(null_out);
+		});
+
+		if (!ok) {
+			fprintf(stderr, "%s: decoding stopped at an unsupported instruction!\n", mix_names[m]);
+			return 1;
+		}
+
+		const double mb = stream_size / 1e6;
+		fprintf(stdout, "%-9s %10zu %10.1f %9.1f %9.1f %11zu | %10.1f %10.1f %9zu\n",
+			mix_names[m], instr_count,
+			mb / decode.seconds, instr_count / decode.seconds / 1e6, double(decode.cycles) / instr_count, decode.allocs,
+			mb / print.seconds, double(print.cycles) / instr_count, print.allocs);
+	}
+
+	fclose(null_out);
+
+	return 0;
+}
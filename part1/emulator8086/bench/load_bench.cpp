@@ -0,0 +1,192 @@
+/**
+ * Compares ways of getting an input file into memory: fread with several
+ * buffer sizes, read(), and mmap with and without MAP_POPULATE.
+ * Every method sums all bytes so the data is really touched.
+ * Cold runs drop the file from the page cache with posix_fadvise first.
+ *
+ * POSIX only, built by CMakeLists.txt as load_bench.
+ * Usage: load_bench <file> [repetitions]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Method {
+	const char *name;
+	uint64_t (*run)(const char *filename, std::size_t size, std::size_t buffer_size);
+	std::size_t buffer_size;
+};
+
+uint64_t sum_bytes(const uint8_t *data, std::size_t size) {
+	uint64_t sum = 0;
+	for (std::size_t i = 0; i < size; ++i) {
+		sum += data[i];
+	}
+	return sum;
+}
+
+uint64_t run_fread(const char *filename, std::size_t size, std::size_t buffer_size) {
+	FILE *f = fopen(filename, "rb");
+	if (!f) {
+		return 0;
+	}
+
+	if (buffer_size == 0) {
+		// Whole file in one call, like main.cpp used to.
+		std::unique_ptr<uint8_t[]> buffer(new uint8_t[size]);
+		std::size_t bytes_read = fread(buffer.get(), 1, size, f);
+		fclose(f);
+		return sum_bytes(buffer.get(), bytes_read);
+	}
+
+	std::unique_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+	setvbuf(f, nullptr, _IONBF, 0);
+
+	uint64_t sum = 0;
+	std::size_t bytes_read = 0;
+	while ((bytes_read = fread(buffer.get(), 1, buffer_size, f)) > 0) {
+		sum += sum_bytes(buffer.get(), bytes_read);
+	}
+	fclose(f);
+
+	return sum;
+}
+
+uint64_t run_read(const char *filename, std::size_t, std::size_t buffer_size) {
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		return 0;
+	}
+
+	std::unique_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+
+	uint64_t sum = 0;
+	ssize_t bytes_read = 0;
+	while ((bytes_read = read(fd, buffer.get(), buffer_size)) > 0) {
+		sum += sum_bytes(buffer.get(), static_cast<std::size_t>(bytes_read));
+	}
+	close(fd);
+
+	return sum;
+}
+
+uint64_t run_mmap(const char *filename, std::size_t size, int flags, int advice) {
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		return 0;
+	}
+
+	void *ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | flags, fd, 0);
+	close(fd);
+	if (ptr == MAP_FAILED) {
+		return 0;
+	}
+
+	if (advice) {
+		madvise(ptr, size, advice);
+	}
+
+	uint64_t sum = sum_bytes(static_cast<const uint8_t *>(ptr), size);
+	munmap(ptr, size);
+
+	return sum;
+}
+
+uint64_t run_mmap_plain(const char *filename, std::size_t size, std::size_t) {
+	return run_mmap(filename, size, 0, 0);
+}
+
+uint64_t run_mmap_sequential(const char *filename, std::size_t size, std::size_t) {
+	return run_mmap(filename, size, 0, MADV_SEQUENTIAL);
+}
+
+uint64_t run_mmap_populate(const char *filename, std::size_t size, std::size_t) {
+	return run_mmap(filename, size, MAP_POPULATE, 0);
+}
+
+bool drop_cache(const char *filename) {
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	int res = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	close(fd);
+
+	return res == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		fprintf(stdout, "Usage: %s <file> [repetitions]\n", argv[0]);
+		return 1;
+	}
+
+	const char *filename = argv[1];
+	const int repetitions = argc > 2 ? atoi(argv[2]) : 10;
+
+	struct stat st;
+	if (stat(filename, &st) != 0 || st.st_size == 0) {
+		fprintf(stderr, "Failed to stat file %s!\n", filename);
+		return 1;
+	}
+	const std::size_t size = static_cast<std::size_t>(st.st_size);
+
+	const Method methods[] = {
+		{ "fread 4K", run_fread, 4 * 1024 },
+		{ "fread 64K", run_fread, 64 * 1024 },
+		{ "fread 1M", run_fread, 1024 * 1024 },
+		{ "fread whole", run_fread, 0 },
+		{ "read 64K", run_read, 64 * 1024 },
+		{ "read 1M", run_read, 1024 * 1024 },
+		{ "mmap", run_mmap_plain, 0 },
+		{ "mmap sequential", run_mmap_sequential, 0 },
+		{ "mmap populate", run_mmap_populate, 0 },
+	};
+
+	const uint64_t expected = run_read(filename, size, 1024 * 1024);
+
+	fprintf(stdout, "%-16s %12s %12s\n", "method", "cold MB/s", "warm MB/s");
+	for (const auto &method : methods) {
+		double best[2] = { 1e9, 1e9 };
+		bool cold_ok = true;
+
+		for (int cold = 1; cold >= 0; --cold) {
+			for (int r = 0; r < repetitions; ++r) {
+				if (cold) {
+					cold_ok = drop_cache(filename) && cold_ok;
+				}
+
+				auto start = Clock::now();
+				uint64_t sum = method.run(filename, size, method.buffer_size);
+				double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+				if (sum != expected) {
+					fprintf(stderr, "%s: checksum mismatch!\n", method.name);
+					return 1;
+				}
+				best[cold] = std::min(best[cold], seconds);
+			}
+		}
+
+		fprintf(stdout, "%-16s %12.1f %12.1f%s\n", method.name, size / best[1] / 1e6, size / best[0] / 1e6,
+			cold_ok ? "" : " (cache drop failed)");
+	}
+
+	return 0;
+}
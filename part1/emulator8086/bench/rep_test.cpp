@@ -0,0 +1,260 @@
+/**
+ * Repetition tests for each phase of the tool: loading the input with
+ * different methods, decode(), print_asm() and emulate(). Every test runs
+ * until it hasn't found a new minimum for the given number of seconds.
+ *
+ * Results go to stderr. The emulate test traces every instruction to stdout,
+ * so redirect it: rep_test <file> [seconds] [max_instructions] > /dev/null
+ * Every emulate() run starts from a reset machine and stops after at most
+ * max_instructions, 1000000 by default.
+ */
+#include "decoder.h"
+#include "emulator.h"
+#include "input_file.h"
+#include "profiler.h"
+#include "repetition_tester.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+using namespace emu8086;
+
+struct Params {
+	const char *filename;
+	std::size_t size;
+	const InputFile *source;
+	const Decoder *decoder;
+	FILE *null_out;
+	std::uint64_t max_instructions;
+};
+
+/**
+ * Reads one byte of every page so mapped files are really faulted in.
+ */
+std::uint64_t touch_pages(const std::uint8_t *data, std::size_t size) {
+	std::uint64_t sum = 0;
+	for (std::size_t i = 0; i < size; i += 4096) {
+		sum += data[i];
+	}
+	return sum;
+}
+
+volatile std::uint64_t sink;
+
+/**
+ * Fresh pages from the OS, malloc would hand back the already mapped
+ * block freed by the previous repetition.
+ */
+std::uint8_t *alloc_pages(std::size_t size) {
+#ifdef _WIN32
+	return static_cast<std::uint8_t *>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+	void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return ptr == MAP_FAILED ? nullptr : static_cast<std::uint8_t *>(ptr);
+#endif
+}
+
+void free_pages(std::uint8_t *ptr, std::size_t size) {
+#ifdef _WIN32
+	VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+	munmap(ptr, size);
+#endif
+}
+
+void test_fread_fresh(RepetitionTester &tester, const Params &params) {
+	while (tester.is_testing()) {
+		FILE *f = fopen(params.filename, "rb");
+		if (!f) {
+			tester.error("fopen failed");
+			break;
+		}
+
+		std::uint8_t *buffer = alloc_pages(params.size);
+		if (!buffer) {
+			tester.error("allocation failed");
+			fclose(f);
+			break;
+		}
+
+		tester.begin_time();
+		const std::size_t bytes_read = fread(buffer, 1, params.size, f);
+		tester.end_time();
+
+		tester.count_bytes(bytes_read);
+		fclose(f);
+		free_pages(buffer, params.size);
+	}
+}
+
+void test_fread_touched(RepetitionTester &tester, const Params &params) {
+	// Same buffer every time, its pages are already mapped after the first run.
+	std::unique_ptr<std::uint8_t[]> buffer(new std::uint8_t[params.size]());
+
+	while (tester.is_testing()) {
+		FILE *f = fopen(params.filename, "rb");
+		if (!f) {
+			tester.error("fopen failed");
+			break;
+		}
+
+		tester.begin_time();
+		const std::size_t bytes_read = fread(buffer.get(), 1, params.size, f);
+		tester.end_time();
+
+		tester.count_bytes(bytes_read);
+		fclose(f);
+	}
+}
+
+void test_input_file(RepetitionTester &tester, const Params &params, LoadMode mode) {
+	while (tester.is_testing()) {
+		InputFile file;
+
+		tester.begin_time();
+		const bool ok = file.open(params.filename, mode);
+		sink = touch_pages(file.data(), file.size());
+		tester.end_time();
+
+		if (!ok) {
+			tester.error("InputFile::open failed");
+			break;
+		}
+		tester.count_bytes(file.size());
+	}
+}
+
+void test_input_read(RepetitionTester &tester, const Params &params) {
+	test_input_file(tester, params, LoadMode::Read);
+}
+
+void test_input_mmap(RepetitionTester &tester, const Params &params) {
+	test_input_file(tester, params, LoadMode::Map);
+}
+
+void test_input_populate(RepetitionTester &tester, const Params &params) {
+	test_input_file(tester, params, LoadMode::MapPopulate);
+}
+
+void test_decode(RepetitionTester &tester, const Params &params) {
+	while (tester.is_testing()) {
+		Decoder decoder;
+
+		tester.begin_time();
+		const bool ok = decoder.decode(params.source->data(), params.size);
+		tester.end_time();
+
+		if (!ok) {
+			tester.error("instruction not supported");
+			break;
+		}
+		tester.count_bytes(params.size);
+	}
+}
+
+void test_print_asm(RepetitionTester &tester, const Params &params) {
+	while (tester.is_testing()) {
+		tester.begin_time();
+		params.decoder->print_asm(params.null_out);
+		fflush(params.null_out);
+		tester.end_time();
+
+		tester.count_bytes(params.size);
+	}
+}
+
+void test_emulate(RepetitionTester &tester, const Params &params) {
+	while (tester.is_testing()) {
+		tester.begin_time();
+		TextTrace trace;
+		emulate(params.source->data(), params.size, trace, params.max_instructions);
+		fflush(stdout);
+		tester.end_time();
+
+		tester.count_bytes(params.size);
+	}
+}
+
+void test_emulate_quiet(RepetitionTester &tester, const Params &params) {
+	while (tester.is_testing()) {
+		tester.begin_time();
+		NoTrace trace;
+		emulate(params.source->data(), params.size, trace, params.max_instructions);
+		tester.end_time();
+
+		tester.count_bytes(params.size);
+	}
+}
+
+struct Test {
+	const char *name;
+	void (*run)(RepetitionTester &tester, const Params &params);
+};
+
+constexpr Test tests[] = {
+	{ "fread fresh buffer", test_fread_fresh },
+	{ "fread touched buffer", test_fread_touched },
+	{ "InputFile read", test_input_read },
+	{ "InputFile mmap", test_input_mmap },
+	{ "InputFile mmap populate", test_input_populate },
+	{ "decode", test_decode },
+	{ "print_asm", test_print_asm },
+	{ "emulate", test_emulate },
+	{ "emulate_quiet", test_emulate_quiet },
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		fprintf(STREAM_ERR, "Usage: %s <filename> [seconds] [max_instructions] > /dev/null\n", argv[0]);
+		return 1;
+	}
+
+	const std::uint32_t seconds = argc > 2 ? static_cast<std::uint32_t>(std::atoi(argv[2])) : 10;
+	const std::uint64_t max_instructions = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000000;
+
+	InputFile source;
+	if (!source.open(argv[1], LoadMode::Read) || source.size() == 0) {
+		fprintf(STREAM_ERR, "Failed to read file %s!\n", argv[1]);
+		return 1;
+	}
+
+	Decoder decoder;
+	if (!decoder.decode(source.data(), source.size())) {
+		fprintf(STREAM_ERR, "instruction not supported! Idx: %zu\n", decoder.instructions().size());
+		return 1;
+	}
+
+#ifdef _WIN32
+	FILE *null_out = fopen("NUL", "wb");
+#else
+	FILE *null_out = fopen("/dev/null", "wb");
+#endif
+	if (!null_out) {
+		fprintf(STREAM_ERR, "Failed to open null output!\n");
+		return 1;
+	}
+
+	const std::uint64_t cpu_freq = estimate_cpu_timer_freq();
+	const Params params = { argv[1], source.size(), &source, &decoder, null_out, max_instructions };
+
+	for (const Test &test : tests) {
+		fprintf(STREAM_ERR, "\n--- %s ---\n", test.name);
+
+		RepetitionTester tester;
+		tester.new_test_wave(params.size, cpu_freq, seconds);
+		test.run(tester, params);
+	}
+
+	fclose(null_out);
+
+	return 0;
+}
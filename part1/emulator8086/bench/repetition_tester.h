@@ -0,0 +1,192 @@
+#pragma once
+
+#include "profiler.h"
+
+#include <cstdint>
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace emu8086 {
+
+inline std::uint64_t read_page_faults() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters = {};
+	counters.cb = sizeof(counters);
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return counters.PageFaultCount;
+#else
+	rusage usage = {};
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_minflt + usage.ru_majflt;
+#endif
+}
+
+/**
+ * Runs a piece of code over and over until it hasn't set a new minimum
+ * time for a while, then reports min/avg/max time, bandwidth and page faults.
+ *
+ *   tester.new_test_wave(bytes, cpu_freq);
+ *   while (tester.is_testing()) {
+ *       tester.begin_time();
+ *       ... work ...
+ *       tester.end_time();
+ *       tester.count_bytes(bytes);
+ *   }
+ */
+class RepetitionTester {
+public:
+	struct Values {
+		std::uint64_t time = 0;
+		std::uint64_t bytes = 0;
+		std::uint64_t page_faults = 0;
+	};
+
+	void new_test_wave(std::uint64_t target_bytes, std::uint64_t cpu_freq, std::uint32_t seconds_to_try = 10) {
+		if (state == State::Uninitialized) {
+			state = State::Testing;
+			expected_bytes = target_bytes;
+			timer_freq = cpu_freq;
+			print_new_minimums = true;
+			min = { ~std::uint64_t(0), 0, 0 };
+		} else if (state == State::Completed) {
+			state = State::Testing;
+			if (expected_bytes != target_bytes) {
+				error("target bytes changed");
+			}
+			if (timer_freq != cpu_freq) {
+				error("CPU frequency changed");
+			}
+		}
+
+		try_for_time = seconds_to_try * cpu_freq;
+		tests_started_at = read_cpu_timer();
+	}
+
+	void begin_time() {
+		++open_blocks;
+		accumulated.time -= read_cpu_timer();
+		accumulated.page_faults -= read_page_faults();
+	}
+
+	void end_time() {
+		accumulated.page_faults += read_page_faults();
+		accumulated.time += read_cpu_timer();
+		++close_blocks;
+	}
+
+	void count_bytes(std::uint64_t bytes) {
+		accumulated.bytes += bytes;
+	}
+
+	void error(const char *message) {
+		state = State::Error;
+		fprintf(STREAM_ERR, "ERROR: %s\n", message);
+	}
+
+	bool is_testing() {
+		if (state != State::Testing) {
+			return false;
+		}
+
+		const std::uint64_t now = read_cpu_timer();
+		if (open_blocks) {
+			if (open_blocks != close_blocks) {
+				error("unbalanced begin_time/end_time");
+			}
+			if (accumulated.bytes != expected_bytes) {
+				error("processed byte count mismatch");
+			}
+
+			if (state == State::Testing) {
+				++count;
+				total.time += accumulated.time;
+				total.bytes += accumulated.bytes;
+				total.page_faults += accumulated.page_faults;
+				if (max.time < accumulated.time) {
+					max = accumulated;
+				}
+				if (min.time > accumulated.time) {
+					min = accumulated;
+					// Any new minimum restarts the clock on how long we keep trying.
+					tests_started_at = now;
+					if (print_new_minimums) {
+						print_value("Min", min);
+						fprintf(STREAM_ERR, "               \r");
+					}
+				}
+
+				open_blocks = 0;
+				close_blocks = 0;
+				accumulated = {};
+			}
+		}
+
+		if (state == State::Testing && now - tests_started_at > try_for_time) {
+			state = State::Completed;
+			fprintf(STREAM_ERR, "                                                          \r");
+			print_results();
+		}
+
+		return state == State::Testing;
+	}
+
+private:
+	enum class State {
+		Uninitialized,
+		Testing,
+		Completed,
+		Error,
+	};
+
+	void print_value(const char *label, const Values &value, double divisor = 1.0) const {
+		const double time = value.time / divisor;
+		const double seconds = time / timer_freq;
+		fprintf(STREAM_ERR, "%s: %.0f (%.3fms)", label, time, 1000.0 * seconds);
+
+		if (value.bytes) {
+			const double gigabytes = (value.bytes / divisor) / (1024.0 * 1024.0 * 1024.0);
+			fprintf(STREAM_ERR, " %.3fgb/s", gigabytes / seconds);
+		}
+		if (value.page_faults) {
+			const double faults = value.page_faults / divisor;
+			fprintf(STREAM_ERR, " PF: %.4f (%.4fk/fault)", faults, (value.bytes / divisor) / (faults * 1024.0));
+		}
+	}
+
+	void print_results() const {
+		print_value("Min", min);
+		fprintf(STREAM_ERR, "\n");
+		print_value("Max", max);
+		fprintf(STREAM_ERR, "\n");
+		if (count) {
+			print_value("Avg", total, double(count));
+			fprintf(STREAM_ERR, "\n");
+		}
+	}
+
+	State state = State::Uninitialized;
+	std::uint64_t expected_bytes = 0;
+	std::uint64_t timer_freq = 0;
+	std::uint64_t try_for_time = 0;
+	std::uint64_t tests_started_at = 0;
+	bool print_new_minimums = true;
+
+	std::uint32_t open_blocks = 0;
+	std::uint32_t close_blocks = 0;
+	Values accumulated;
+
+	std::uint64_t count = 0;
+	Values total;
+	Values min;
+	Values max;
+};
+
+} // namespace emu8086
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "memory.h"
+
+#include <array>
+#include <cstdint>
+
+// x86 hosts keep the 8086 arithmetic flags in the same bits, define HOST_FLAGS=0 to use the tables anyway
+#ifndef HOST_FLAGS
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HOST_FLAGS 1
+#else
+#define HOST_FLAGS 0
+#endif
+#endif
+
+namespace emu8086 {
+
+constexpr uint16_t CF_BIT = 0x0001;
+constexpr uint16_t PF_BIT = 0x0004;
+constexpr uint16_t AF_BIT = 0x0010;
+constexpr uint16_t ZF_BIT = 0x0040;
+constexpr uint16_t SF_BIT = 0x0080;
+constexpr uint16_t OF_BIT = 0x0800;
+
+constexpr uint16_t ARITHMETIC_FLAGS = CF_BIT | PF_BIT | AF_BIT | ZF_BIT | SF_BIT | OF_BIT;
+
+/**
+ * SF, ZF and PF of every byte result
+ */
+constexpr std::array<uint8_t, 256> make_szp_table() {
+	std::array<uint8_t, 256> table{};
+	for (int i = 0; i < 256; ++i) {
+		int bits = 0;
+		for (int b = 0; b < 8; ++b) {
+			bits += (i >> b) & 1;
+		}
+
+		table[i] = uint8_t((i & 0x80 ? SF_BIT : 0) | (i == 0 ? ZF_BIT : 0) | (bits % 2 == 0 ? PF_BIT : 0));
+	}
+
+	return table;
+}
+
+inline constexpr std::array<uint8_t, 256> szp_table = make_szp_table();
+
+/**
+ * Arithmetic flags an operation defines, the others keep their value
+ */
+constexpr uint16_t flag_op_mask(FlagOp op) {
+	switch (op) {
+	case FlagOp::None:
+		return 0;
+	case FlagOp::Inc:
+	case FlagOp::Dec:
+		return ARITHMETIC_FLAGS & ~CF_BIT;
+	default:
+		return ARITHMETIC_FLAGS;
+	}
+}
+
+inline uint16_t szp_flags(uint16_t result, bool wide) {
+	if (!wide) {
+		return szp_table[result & 0xFF];
+	}
+
+	return (szp_table[result & 0xFF] & PF_BIT) | (szp_table[result >> 8] & SF_BIT) | (result == 0 ? ZF_BIT : 0);
+}
+
+/**
+ * Portable flags of dest op src (+ carry) = result, all masked to the operation width.
+ */
+inline uint16_t table_alu_flags(FlagOp op, uint16_t dest, uint16_t src, uint16_t result, bool carry, bool wide) {
+	const uint16_t sign_bit = wide ? 0x8000 : 0x80;
+	const bool add = op == FlagOp::Add || op == FlagOp::Adc || op == FlagOp::Inc;
+
+	uint16_t res = szp_flags(result, wide);
+	res |= (dest ^ src ^ result) & AF_BIT;
+	const bool carry_out = add ? result < dest || (carry && result == dest) : uint32_t(src) + carry > dest;
+	res |= carry_out ? CF_BIT : 0;
+
+	const uint16_t overflow = add ? (dest ^ result) & (src ^ result) : (dest ^ src) & (dest ^ result);
+	res |= (overflow & sign_bit) ? OF_BIT : 0;
+
+	return res;
+}
+
+#if HOST_FLAGS
+/**
+ * Runs the operation on the host and reads its flags with lahf and seto,
+ * pushf would write below the stack pointer into the red zone.
+ */
+template<typename T>
+uint16_t host_alu_flags(FlagOp op, T dest, T src, bool carry) {
+	uint16_t ax;
+	switch (op) {
+	case FlagOp::Add:
+	case FlagOp::Inc:
+		asm("add %2, %1\n\tlahf\n\tseto %%al" : "=&a"(ax), "+q"(dest) : "q"(src) : "cc");
+		break;
+	case FlagOp::Adc:
+		asm("bt $0, %k3\n\tadc %2, %1\n\tlahf\n\tseto %%al" : "=&a"(ax), "+q"(dest) : "q"(src), "r"(uint32_t(carry)) : "cc");
+		break;
+	case FlagOp::Sbb:
+		asm("bt $0, %k3\n\tsbb %2, %1\n\tlahf\n\tseto %%al" : "=&a"(ax), "+q"(dest) : "q"(src), "r"(uint32_t(carry)) : "cc");
+		break;
+	default:
+		asm("sub %2, %1\n\tlahf\n\tseto %%al" : "=&a"(ax), "+q"(dest) : "q"(src) : "cc");
+		break;
+	}
+
+	return ((ax >> 8) & (SF_BIT | ZF_BIT | AF_BIT | PF_BIT | CF_BIT)) | ((ax & 1) ? OF_BIT : 0);
+}
+#endif
+
+/**
+ * @breif Arithmetic flags set by dest op src = result, all masked to the operation width.
+ * Carry in of adc and sbb is recovered from the result.
+ */
+inline uint16_t alu_flags(FlagOp op, uint16_t dest, uint16_t src, uint16_t result, bool wide) {
+	if (op == FlagOp::Logic) {
+		return szp_flags(result, wide);
+	}
+
+	const bool carry = (op == FlagOp::Adc && ((result - dest - src) & 1)) || (op == FlagOp::Sbb && ((dest - src - result) & 1));
+#if HOST_FLAGS
+	return wide ? host_alu_flags<uint16_t>(op, dest, src, carry) : host_alu_flags<uint8_t>(op, uint8_t(dest), uint8_t(src), carry);
+#else
+	return table_alu_flags(op, dest, src, result, carry, wide);
+#endif
+}
+
+} // namespace emu8086
@@ -0,0 +1,30 @@
+#include "asm_writer.h"
+
+namespace emu8086 {
+
+AsmWriter::AsmWriter(FILE *out, std::size_t capacity)
+	: out(out), buffer(new char[capacity]), capacity(capacity) {
+}
+
+AsmWriter::AsmWriter(std::string &sink, std::size_t capacity)
+	: sink(&sink), buffer(new char[capacity]), capacity(capacity) {
+}
+
+AsmWriter::~AsmWriter() {
+	flush();
+}
+
+void AsmWriter::flush() {
+	if (size == 0) {
+		return;
+	}
+
+	if (sink) {
+		sink->append(buffer.get(), size);
+	} else {
+		fwrite(buffer.get(), 1, size, out);
+	}
+	size = 0;
+}
+
+} // namespace emu8086
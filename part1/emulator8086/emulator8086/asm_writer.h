@@ -0,0 +1,66 @@
+#pragma once
+
+#include "emu8086.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace emu8086 {
+
+/**
+ * Collects text in a large buffer and hands it to the FILE with one fwrite
+ * per block, instead of one locked, format parsed fprintf per field.
+ * Can also append to a string, to format on one thread and write on another.
+ * Flushes on destruction.
+ */
+class AsmWriter {
+public:
+	// Longest line a single put_* sequence may produce between reserve() calls
+	static constexpr std::size_t MAX_LINE = 128;
+
+	explicit AsmWriter(FILE *out, std::size_t capacity = 256 * 1024);
+	explicit AsmWriter(std::string &sink, std::size_t capacity = 256 * 1024);
+	~AsmWriter();
+
+	AsmWriter(const AsmWriter &) = delete;
+	AsmWriter &operator=(const AsmWriter &) = delete;
+
+	/**
+	 * Makes sure at least MAX_LINE bytes can be written without checking.
+	 */
+	void reserve() {
+		if (capacity - size < MAX_LINE) {
+			flush();
+		}
+	}
+
+	void put(char c) {
+		buffer[size++] = c;
+	}
+
+	void put(std::string_view str) {
+		std::memcpy(buffer.get() + size, str.data(), str.size());
+		size += str.size();
+	}
+
+	template<typename T>
+	void put_int(T value) {
+		auto res = std::to_chars(buffer.get() + size, buffer.get() + capacity, value);
+		size = res.ptr - buffer.get();
+	}
+
+	void flush();
+
+private:
+	FILE *out = nullptr;
+	std::string *sink = nullptr;
+	std::unique_ptr<char[]> buffer;
+	std::size_t capacity;
+	std::size_t size = 0;
+};
+
+} // namespace emu8086
@@ -0,0 +1,106 @@
+#include "block_cache.h"
+
+#include <algorithm>
+
+namespace emu8086 {
+
+static bool ends_block(const Instruction &instr) {
+	if (instr.type == InstructionType::Jmp) {
+		return true;
+	}
+
+	switch (instr.opcode) {
+	case InstructionOpcode::call:
+	case InstructionOpcode::jmp:
+	case InstructionOpcode::ret:
+	case InstructionOpcode::retf:
+	case InstructionOpcode::iret:
+	case InstructionOpcode::int_:
+	case InstructionOpcode::int3:
+	case InstructionOpcode::into:
+	case InstructionOpcode::hlt:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static uint32_t first_page(const Block &block) {
+	return block.addr >> CODE_PAGE_BITS;
+}
+
+static uint32_t last_page(const Block &block) {
+	return ((block.end - 1) & ADDRESS_MASK) >> CODE_PAGE_BITS;
+}
+
+Block *BlockCache::get(uint32_t addr, uint32_t max_size) {
+	auto it = blocks.find(addr);
+	if (it != blocks.end()) {
+		return it->second.get();
+	}
+
+	return translate(addr, max_size);
+}
+
+Block *BlockCache::translate(uint32_t addr, uint32_t max_size) {
+	auto block = std::make_unique<Block>();
+	block->addr = addr;
+
+	uint32_t size = 0;
+	while (size < max_size && block->instrs.size() < MAX_BLOCK_SIZE) {
+		const InstructionCache::Entry *entry = instr_cache.fetch((addr + size) & ADDRESS_MASK);
+		if (!entry) {
+			break;
+		}
+
+		block->instrs.push_back(*entry);
+		size += entry->length;
+		if (ends_block(entry->instr)) {
+			break;
+		}
+	}
+
+	if (block->instrs.empty()) {
+		return nullptr;
+	}
+
+	block->end = (addr + size) & ADDRESS_MASK;
+	// Dispatch runs into it instead of checking for the end of the block
+	block->instrs.emplace_back();
+
+	Block *res = block.get();
+	for (uint32_t page = first_page(*res); ; page = last_page(*res)) {
+		mark_code_page(page);
+		page_blocks[page].push_back(res);
+		if (page == last_page(*res)) {
+			break;
+		}
+	}
+	blocks.emplace(addr, std::move(block));
+
+	return res;
+}
+
+void BlockCache::invalidate_written() {
+	for (uint32_t page : take_written_code_pages()) {
+		instr_cache.invalidate(page);
+
+		for (Block *block : page_blocks[page]) {
+			// Blocks crossing a page boundary are listed on both pages
+			const uint32_t other = page == first_page(*block) ? last_page(*block) : first_page(*block);
+			if (other != page) {
+				std::erase(page_blocks[other], block);
+			}
+			blocks.erase(block->addr);
+		}
+		page_blocks[page].clear();
+	}
+
+	// Surviving blocks may be chained to dropped ones
+	for (auto &[addr, block] : blocks) {
+		block->links[0] = {};
+		block->links[1] = {};
+	}
+}
+
+} // namespace emu8086
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "emu8086.h"
+#include "instr_cache.h"
+#include "memory.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace emu8086 {
+
+/**
+ * Instructions which always run one after the other, ending at a jump, call, return or hlt.
+ */
+struct Block {
+	/**
+	 * Block control went to the last time it left this one for addr.
+	 */
+	struct Link {
+		uint32_t addr = UINT32_MAX;
+		Block *block = nullptr;
+	};
+
+	uint32_t addr; // physical address of the first instruction
+	uint32_t end; // physical address right after the last instruction
+	std::vector<InstructionCache::Entry> instrs; // the last one is an END_OF_BLOCK entry
+	Link links[2]; // falling through to end, taken branch
+};
+
+constexpr std::size_t MAX_BLOCK_SIZE = 64;
+
+/**
+ * Blocks translated from guest memory keyed by physical address of their first instruction.
+ * Pages holding translated code are marked in guest memory, writing to one
+ * drops every block and decoded instruction on it in invalidate_written().
+ */
+class BlockCache {
+public:
+	/**
+	 * @return block starting at addr, translated on first use from at most max_size bytes.
+	 * nullptr if there is no supported instruction at addr.
+	 */
+	Block *get(uint32_t addr, uint32_t max_size);
+
+	/**
+	 * Like get() for the block control goes to after from, the lookup is skipped when from was chained to it before.
+	 */
+	Block *next(Block &from, uint32_t addr, uint32_t max_size) {
+		Block::Link &link = from.links[addr != from.end];
+		if (link.addr != addr) {
+			link = { addr, get(addr, max_size) };
+		}
+
+		return link.block;
+	}
+
+	/**
+	 * Drops blocks on pages written since they were translated, which can include the one being executed.
+	 * No Block from before may be used afterwards.
+	 */
+	void invalidate_written();
+
+private:
+	Block *translate(uint32_t addr, uint32_t max_size);
+
+	InstructionCache instr_cache;
+	std::unordered_map<uint32_t, std::unique_ptr<Block>> blocks;
+	std::vector<Block *> page_blocks[CODE_PAGE_COUNT];
+};
+
+} // namespace emu8086
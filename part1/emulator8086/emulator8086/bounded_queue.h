@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace emu8086 {
+
+/**
+ * Blocking FIFO with a fixed capacity for handing work between pipeline stages.
+ * push() waits while the queue is full, pop() waits while it is empty.
+ * After close() pushes are dropped and pop() drains what is left, then returns nullopt.
+ */
+template<typename T>
+class BoundedQueue {
+public:
+	explicit BoundedQueue(std::size_t capacity) : capacity(capacity) {}
+
+	bool push(T value) {
+		std::unique_lock lock(mutex);
+		not_full.wait(lock, [this]() { return closed || items.size() < capacity; });
+		if (closed) {
+			return false;
+		}
+
+		items.push_back(std::move(value));
+		lock.unlock();
+		not_empty.notify_one();
+
+		return true;
+	}
+
+	std::optional<T> pop() {
+		std::unique_lock lock(mutex);
+		not_empty.wait(lock, [this]() { return closed || !items.empty(); });
+		if (items.empty()) {
+			return std::nullopt;
+		}
+
+		T value = std::move(items.front());
+		items.pop_front();
+		lock.unlock();
+		not_full.notify_one();
+
+		return value;
+	}
+
+	void close() {
+		{
+			std::lock_guard lock(mutex);
+			closed = true;
+		}
+		not_full.notify_all();
+		not_empty.notify_all();
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable not_full;
+	std::condition_variable not_empty;
+	std::deque<T> items;
+	std::size_t capacity;
+	bool closed = false;
+};
+
+} // namespace emu8086
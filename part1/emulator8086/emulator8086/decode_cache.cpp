@@ -0,0 +1,134 @@
+#include "decode_cache.h"
+#include "decoder.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace emu8086 {
+
+static std::uint64_t mix(std::uint64_t h) {
+	h ^= h >> 32;
+	h *= 0xd6e8feb86659fd93ull;
+	h ^= h >> 32;
+	return h;
+}
+
+std::uint64_t hash_input(const std::uint8_t *data, std::size_t size) {
+	// Four independent lanes so the multiplies don't wait on each other.
+	std::uint64_t lanes[4] = {
+		0x9e3779b97f4a7c15ull, 0xbf58476d1ce4e5b9ull, 0x94d049bb133111ebull, 0x2545f4914f6cdd1dull,
+	};
+
+	std::size_t pos = 0;
+	for (; pos + 32 <= size; pos += 32) {
+		for (int i = 0; i < 4; ++i) {
+			std::uint64_t word;
+			std::memcpy(&word, data + pos + i * 8, sizeof(word));
+			lanes[i] = (lanes[i] ^ word) * 0x9e3779b97f4a7c15ull;
+			lanes[i] ^= lanes[i] >> 29;
+		}
+	}
+
+	std::uint64_t h = size;
+	for (int i = 0; i < 4; ++i) {
+		h = mix(h ^ lanes[i]);
+	}
+	for (; pos < size; ++pos) {
+		h = (h ^ data[pos]) * 0x100000001b3ull;
+	}
+
+	return mix(h);
+}
+
+static constexpr std::uint32_t opcode_count = sizeof(instr_opcode_names) / sizeof(instr_opcode_names[0]);
+
+bool Decoder::save_cache(const char *path, std::uint64_t input_hash, std::size_t input_size) const {
+	DecodeCacheHeader header = {};
+	std::memcpy(header.magic, DECODE_CACHE_MAGIC, sizeof(header.magic));
+	header.version = DECODE_CACHE_VERSION;
+	header.record_size = sizeof(Instruction);
+	header.opcode_count = opcode_count;
+	header.code_size = code_size;
+	header.input_size = input_size;
+	header.input_hash = input_hash;
+	header.instr_count = instr_view.size();
+	header.label_count = label_view.size();
+
+	// Written under a temporary name and renamed, so a reader never maps a
+	// half written file.
+	std::string tmp_path = std::string(path) + ".tmp";
+	FILE *f = fopen(tmp_path.c_str(), "wb");
+	if (!f) {
+		return false;
+	}
+
+	bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+	ok = ok && fwrite(instr_view.data(), sizeof(Instruction), instr_view.size(), f) == instr_view.size();
+	ok = ok && fwrite(offset_view.data(), sizeof(uint32_t), offset_view.size(), f) == offset_view.size();
+	ok = ok && fwrite(label_view.data(), sizeof(uint32_t), label_view.size(), f) == label_view.size();
+	ok = (fclose(f) == 0) && ok;
+
+	if (ok) {
+		std::remove(path);
+		ok = std::rename(tmp_path.c_str(), path) == 0;
+	}
+	if (!ok) {
+		std::remove(tmp_path.c_str());
+	}
+
+	return ok;
+}
+
+bool Decoder::load_cache(const char *path, std::uint64_t input_hash, std::size_t input_size) {
+	auto file = std::make_unique<InputFile>();
+	if (!file->open(path, LoadMode::Map) || file->size() < sizeof(DecodeCacheHeader)) {
+		return false;
+	}
+
+	DecodeCacheHeader header;
+	std::memcpy(&header, file->data(), sizeof(header));
+	if (std::memcmp(header.magic, DECODE_CACHE_MAGIC, sizeof(header.magic)) != 0
+		|| header.version != DECODE_CACHE_VERSION
+		|| header.record_size != sizeof(Instruction)
+		|| header.opcode_count != opcode_count
+		|| header.input_size != input_size
+		|| header.input_hash != input_hash) {
+		return false;
+	}
+
+	// Bound both counts by the file size first so the products below can't wrap
+	std::size_t remaining = file->size() - sizeof(DecodeCacheHeader);
+	if (header.instr_count > remaining / (sizeof(Instruction) + sizeof(uint32_t))) {
+		return false;
+	}
+	remaining -= header.instr_count * (sizeof(Instruction) + sizeof(uint32_t));
+	if (header.label_count > remaining / sizeof(uint32_t)) {
+		return false;
+	}
+
+	const std::size_t expected_size = sizeof(DecodeCacheHeader)
+		+ header.instr_count * (sizeof(Instruction) + sizeof(uint32_t))
+		+ header.label_count * sizeof(uint32_t);
+	if (file->size() != expected_size) {
+		return false;
+	}
+
+	const uint8_t *records = file->data() + sizeof(DecodeCacheHeader);
+	const uint8_t *offset_data = records + header.instr_count * sizeof(Instruction);
+	const uint8_t *label_data = offset_data + header.instr_count * sizeof(uint32_t);
+
+	decoded.clear();
+	offsets.clear();
+	labels.clear();
+	code_size = header.code_size;
+	instr_view = { reinterpret_cast<const Instruction *>(records), header.instr_count };
+	offset_view = { reinterpret_cast<const uint32_t *>(offset_data), header.instr_count };
+	label_view = { reinterpret_cast<const uint32_t *>(label_data), header.label_count };
+	cache = std::move(file);
+
+	return true;
+}
+
+} // namespace emu8086
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "emu8086.h"
+
+#include <cstdint>
+
+namespace emu8086 {
+
+/**
+ * Decode cache file, written next to an input as <input>.decoded.cache:
+ *
+ *   DecodeCacheHeader
+ *   Instruction records[instr_count]  (16 bytes each, as in memory)
+ *   uint32_t offsets[instr_count]     (byte offset of each instruction)
+ *   uint32_t labels[label_count]      (sorted jump targets)
+ *
+ * Everything is little-endian and laid out so the file can be mapped and
+ * used without parsing. Bump DECODE_CACHE_VERSION whenever Instruction,
+ * its enums or the label rules change.
+ */
+constexpr char DECODE_CACHE_MAGIC[8] = { 'E', 'M', 'U', '8', '0', '8', '6', 'C' };
+constexpr std::uint32_t DECODE_CACHE_VERSION = 1;
+
+struct DecodeCacheHeader {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t record_size; // sizeof(Instruction)
+	std::uint32_t opcode_count; // guards against regenerated instruction tables
+	std::uint32_t code_size;
+	std::uint64_t input_size;
+	std::uint64_t input_hash;
+	std::uint64_t instr_count;
+	std::uint64_t label_count;
+	std::uint8_t reserved[8];
+};
+
+static_assert(sizeof(DecodeCacheHeader) == 64, "records must start 16 byte aligned");
+
+/**
+ * Fast non-cryptographic hash of an input, only used to tell whether a
+ * cache file still matches it.
+ */
+std::uint64_t hash_input(const std::uint8_t *data, std::size_t size);
+
+} // namespace emu8086
@@ -1,26 +1,28 @@
 #include "decoder.h"
+#include "asm_writer.h"
+#include "bounded_queue.h"
+#include "profiler.h"
 #include "instructions.h"
 
+#include <algorithm>
 #include <bit>
 #include <cassert>
+#include <climits>
 #include <cstdio>
-#include <format>
+#include <cstring>
+#include <map>
 #include <optional>
-#include <string>
-#include <unordered_map>
+#include <span>
+#include <thread>
 #include <utility>
 
-namespace emu8086 {
-
-std::vector<Instruction> decoded;
-std::unordered_map<std::size_t, int> labels;
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
-enum MemoryMode {
-	NO_DISPLACEMENT = 0b00,
-	SHORT = 0b01,
-	WIDE = 0b10, 
-	REGISTER = 0b11,
-};
+namespace emu8086 {
 
 int16_t bitwise_abs(int16_t num) {
 	int16_t mask = num >> 15;
@@ -36,72 +38,57 @@ struct RegMemLike {
 	bool sign_extended;
 };
 
-[[nodiscard]] RegMemLike handle_regmemlike(const uint8_t *&source, Instruction &instr, bool force_wide = false) {
-	const uint8_t opcode = *source++;
-	const uint8_t mem = *source++;
+/**
+ * Unaligned little-endian load. Decoder input is padded with
+ * DECODE_PADDING bytes so this never reads past the buffer.
+ */
+uint16_t load_u16(const uint8_t *source) {
+	uint16_t res;
+	memcpy(&res, source, sizeof(res));
+	return res;
+}
+
+[[nodiscard]] RegMemLike handle_regmemlike(const uint8_t *&source, Instruction &instr, uint8_t opcode, bool force_wide = false) {
+	++source;
+	const ModRMInfo &info = modrm_table[*source++];
 
 	const bool dest = (opcode & D_MASK) != 0;
 	const bool wide = (opcode & W_MASK) || force_wide;
 	const bool sign_extended = (opcode & S_MASK) != 0;
 
-	const uint8_t mode = (mem & MOD_MASK) >> 6;
-	const uint8_t reg = (mem & SB_REG_MASK) >> 3;
-	const uint8_t regmem = (mem & REGMEM_MASK);
-	const uint8_t seg_reg = (mem & SR_MASK) >> 3;
-
 	instr.flags.dest = dest;
 	instr.flags.wide = wide;
 
-	if (mode == MemoryMode::REGISTER) {
-		instr.operands[0].type = OperandType::Register;
-		instr.operands[0].reg = get_register(regmem, wide);
-	} else {
-		instr.operands[0].type = OperandType::EffectiveAddress;
-		instr.operands[0].eff_addr = get_eff_addr(regmem);
-
-		if (mode == MemoryMode::SHORT) {
-			int8_t disp = *source++;
-			if (is_seg_prefix(static_cast<uint8_t>(disp))) {
-				instr.operands[0].seg_prefix = disp;
-				disp = *source++;
-			}
-			instr.operands[0].displacement = disp;
-		} else if (mode == MemoryMode::WIDE || regmem == 0x6) {
-			uint8_t disp_l = *source++;
-			if (is_seg_prefix(disp_l)) {
-				instr.operands[0].seg_prefix = disp_l;
-				disp_l = *source++;
-			}
-			uint8_t disp_h = *source++;
-			int16_t disp = disp_l | (int16_t(bool(disp_h)) * (disp_h << 8) + int16_t(!bool(disp_h)) * (disp_l & 0x8000));
-			instr.operands[0].displacement = disp;
+	// EffectiveAddress shares the byte with the register name
+	instr.operands[0].type = info.type;
+	instr.operands[0].reg = static_cast<RegisterName>(info.regmem[wide]);
 
-			if (mode != MemoryMode::WIDE) { // Direct acess
-				instr.operands[0].type = OperandType::DirectAccess;
-			}
-		}
-	}
+	const uint16_t disp = uint16_t(load_u16(source) << info.disp_shift);
+	instr.operands[0].displacement = int16_t(int16_t(disp) >> info.disp_shift) & info.disp_mask;
+	source += info.disp_size;
 
-	return { reg, seg_reg, wide, sign_extended };
+	return { info.reg, uint8_t(info.reg & 0x3), wide, sign_extended };
 }
 
-void handle_regmem_reg(const uint8_t *&source, Instruction &instr) {
-	RegMemLike res = handle_regmemlike(source, instr);
+void handle_regmem_reg(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	RegMemLike res = handle_regmemlike(source, instr, opcode);
 
 	instr.operands[1].type = OperandType::Register;
 	instr.operands[1].reg = get_register(res.reg, res.wide);
 }
 
 int16_t get_imm_data(const uint8_t *&source, bool wide, bool sign_extended = false) {
-	int8_t data_l = *source++;
-	uint8_t data_h = wide && !sign_extended ? *source++ : 0;
-	int16_t data = *reinterpret_cast<uint8_t *>(&data_l) | (data_h << 8);
+	const bool full = wide && !sign_extended;
+	const uint16_t data = load_u16(source);
+	source += 1 + full;
 
-	return wide && !sign_extended ? data : data_l;
+	return full ? int16_t(data) : int16_t(int8_t(data));
 }
 
-void handle_imm_regmem(const uint8_t *&source, Instruction &instr, bool sign_ext = false) {
-	RegMemLike res = handle_regmemlike(source, instr);
+void handle_imm_regmem(const uint8_t *&source, Instruction &instr, uint8_t opcode, bool sign_ext = false) {
+	PROFILE_FUNCTION;
+	RegMemLike res = handle_regmemlike(source, instr, opcode);
 
 	// TODO: this is actually a hack since we don't handle
 	// the case when the instruction does not have a destination bit
@@ -114,15 +101,16 @@ void handle_imm_regmem(const uint8_t *&source, Instruction &instr, bool sign_ext
 }
 
 void handle_imm(const uint8_t *&source, Instruction &instr, bool wide) {
+	PROFILE_FUNCTION;
 	++source;
 
 	instr.operands[0].type = OperandType::Immediate;
 	instr.operands[0].imm_value = get_imm_data(source, wide);
 }
 
-void handle_imm_reg(const uint8_t *&source, Instruction &instr) {
-	
-	const uint8_t opcode = *source++;
+void handle_imm_reg(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 	const uint8_t reg = (opcode & FB_REG_MASK);
 
 	instr.flags.wide = (opcode & IMM_W_MASK);
@@ -134,13 +122,13 @@ void handle_imm_reg(const uint8_t *&source, Instruction &instr) {
 	instr.operands[1].imm_value = get_imm_data(source, instr.flags.wide);
 }
 
-void handle_mem_acc(const uint8_t *&source, Instruction &instr) {
-	
-	const uint8_t opcode = *source++;
+void handle_mem_acc(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 
 	instr.flags.wide = (opcode & W_MASK);
-	uint16_t addr = *source++;
-	addr = addr | (*source++ << 8);
+	uint16_t addr = load_u16(source);
+	source += 2;
 
 	instr.operands[1].type = OperandType::DirectAccess;
 	instr.operands[1].direct_access = addr;
@@ -148,13 +136,13 @@ void handle_mem_acc(const uint8_t *&source, Instruction &instr) {
 	instr.operands[0].type = OperandType::Accumulator;
 }
 
-void handle_acc_mem(const uint8_t *&source, Instruction &instr) {
-	
-	const uint8_t opcode = *source++;
+void handle_acc_mem(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 
 	instr.flags.wide = (opcode & W_MASK);
-	uint16_t addr = *source++;
-	addr = addr | (*source++ << 8);
+	uint16_t addr = load_u16(source);
+	source += 2;
 	
 	instr.operands[0].type = OperandType::DirectAccess;
 	instr.operands[0].direct_access = addr;
@@ -162,9 +150,9 @@ void handle_acc_mem(const uint8_t *&source, Instruction &instr) {
 	instr.operands[1].type = OperandType::Accumulator;
 }
 
-void handle_imm_acc(const uint8_t *&source, Instruction &instr) {
-	
-	const uint8_t opcode = *source++;
+void handle_imm_acc(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 
 	instr.flags.wide = (opcode & W_MASK);
 	int16_t data = get_imm_data(source, instr.flags.wide);
@@ -176,88 +164,88 @@ void handle_imm_acc(const uint8_t *&source, Instruction &instr) {
 }
 
 void handle_jmp(const uint8_t *&source, Instruction &instr) {
-	
-	const uint8_t opcode = *source++;
+	PROFILE_FUNCTION;
+	++source;
 
 	int8_t offset = *source++;
 
-	// Each jmp instruction is 2 bytes and offset is given in bytes
-	// so if we want to count offset by instructions we divide by 2
-	int instr_offset = (offset >> 1);
-	std::size_t line = decoded.size() + instr_offset;
-	if (!labels.contains(line)) {
-		labels.insert({ line, static_cast<int>(labels.size()) });
-	}
-	
 	instr.operands[0].type = OperandType::Label;
 	instr.operands[0].jmp_offset = offset;
 }
 
-void handle_regmem(const uint8_t *&source, Instruction &instr) {
-	std::ignore = handle_regmemlike(source, instr);
+void handle_regmem(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	std::ignore = handle_regmemlike(source, instr, opcode);
 }
 
-void handle_regmem_1(const uint8_t *&source, Instruction &instr) {
-	std::ignore = handle_regmemlike(source, instr);
+void handle_regmem_1(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	std::ignore = handle_regmemlike(source, instr, opcode);
 	instr.operands[1].type = OperandType::Immediate;
 	instr.operands[1].imm_value = 1;
 }
 
-void handle_regmem_CL(const uint8_t *&source, Instruction &instr) {
-	std::ignore = handle_regmemlike(source, instr);
+void handle_regmem_CL(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	std::ignore = handle_regmemlike(source, instr, opcode);
 	instr.operands[1].type = OperandType::Register;
 	instr.operands[1].reg = RegisterName::CL;
 
 	instr.flags.dest = false;
 }
 
-void handle_mem_reg(const uint8_t *&source, Instruction &instr) {
-	auto res = handle_regmemlike(source, instr);
+void handle_mem_reg(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	auto res = handle_regmemlike(source, instr, opcode);
 	instr.operands[1] = instr.operands[0];
 
 	instr.operands[0].type = OperandType::Register;
 	instr.operands[0].reg = get_register(res.reg, res.wide);
 }
 
-void handle_esc(const uint8_t *&source, Instruction &instr) {
-	auto fb = *source;
+void handle_esc(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
 	auto sb = *(source + 1);
 
 	int16_t data = 0;
-	data = data | (fb & 0x07);
+	data = data | (opcode & 0x07);
 	data = data | ((sb & 0x38));
 
-	auto res = handle_regmemlike(source, instr);
+	std::ignore = handle_regmemlike(source, instr, opcode);
 	instr.operands[1] = instr.operands[0];
 
 	instr.operands[0].type = OperandType::Immediate;
 	instr.operands[0].imm_value = data;
 }
 
-void handle_reg(const uint8_t *&source, Instruction &instr) {
-	const uint8_t opcode = *source++;
+void handle_reg(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 	const uint8_t reg = (opcode & FB_REG_MASK);
 	instr.operands[0].type = OperandType::Register;
 	instr.operands[0].reg = get_register(reg, true);
 }
 
-void handle_seg_reg(const uint8_t *&source, Instruction &instr) {
-	const uint8_t opcode = *source++;
+void handle_seg_reg(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 	const uint8_t seg_reg = (opcode & SR_MASK) >> 3;
 
 	instr.operands[0].type = OperandType::SegmentRegister;
 	instr.operands[0].seg_reg = get_seg_reg(seg_reg);
 }
 
-void handle_sr_regmem(const uint8_t *&source, Instruction &instr) {
-	auto res = handle_regmemlike(source, instr, true);
+void handle_sr_regmem(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	auto res = handle_regmemlike(source, instr, opcode, true);
 
 	instr.operands[1].type = OperandType::SegmentRegister;
 	instr.operands[1].seg_reg = get_seg_reg(res.seg_reg);
 }
 
-void handle_reg_acc(const uint8_t *&source, Instruction &instr) {
-	const uint8_t opcode = *source++;
+void handle_reg_acc(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 	const uint8_t reg = (opcode & FB_REG_MASK);
 
 	instr.operands[0].type = OperandType::Accumulator;
@@ -268,8 +256,9 @@ void handle_reg_acc(const uint8_t *&source, Instruction &instr) {
 	instr.flags.wide = true;
 }
 
-void handle_fixed_port(const uint8_t *&source, Instruction &instr) {
-	auto opcode = *source++;
+void handle_fixed_port(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 
 	instr.flags.wide = (opcode & W_MASK);
 	instr.flags.dest = (opcode & D_MASK) >> 1;
@@ -282,8 +271,9 @@ void handle_fixed_port(const uint8_t *&source, Instruction &instr) {
 	instr.operands[1].imm_value = data;
 }
 
-void handle_var_port(const uint8_t *&source, Instruction &instr) {
-	auto opcode = *source++;
+void handle_var_port(const uint8_t *&source, Instruction &instr, uint8_t opcode) {
+	PROFILE_FUNCTION;
+	++source;
 
 	instr.flags.wide = (opcode & W_MASK);
 	instr.flags.dest = (opcode & D_MASK) >> 1;
@@ -295,6 +285,7 @@ void handle_var_port(const uint8_t *&source, Instruction &instr) {
 }
 
 void handle_far_proc(const uint8_t *&source, Instruction &instr) {
+	PROFILE_FUNCTION;
 	++source;
 	auto ip_inc = get_imm_data(source, true);
 	auto cs = get_imm_data(source, true);
@@ -304,259 +295,742 @@ void handle_far_proc(const uint8_t *&source, Instruction &instr) {
 	instr.operands[0].far_proc_cs = cs;
 }
 
-void decode(const uint8_t *source, std::size_t source_size) {
-	auto og_src = source;
-
+/**
+ * Prefixes seen so far which apply to the next decoded instruction.
+ */
+struct DecodeState {
 	uint8_t sr_prefix = 0xff;
 	bool locked = false;
 	bool repeated = false;
-	while (source < og_src + source_size) {
-		const uint8_t opcode = *source;
+	bool unknown = false; // stopped at an unknown opcode
+};
+
+/**
+ * Decodes one instruction starting at source and advances source past it.
+ * Returns false if only a prefix was consumed or the opcode is unknown.
+ */
+using DecodeFn = bool (*)(const uint8_t *&source, Instruction &instr, DecodeState &state);
+
+/**
+ * Applies pending prefixes and puts the operands in destination, source order.
+ */
+void finish_instr(Instruction &instr, DecodeState &state) {
+	if (instr.operands[1].type != OperandType::None && instr.flags.dest) {
+		std::swap(instr.operands[0], instr.operands[1]);
+		instr.flags.dest = false;
+	}
 
-		Instruction instr = get_instruction(opcode);
-		bool special = false;
-		if (instr.type == InstructionType::Special) {
-			special = true;
-			auto snd_byte = *(source+1);
-			instr = get_special_instruction(instr, snd_byte);
+	// Segment prefix only applies to the instruction right after it
+	if (state.sr_prefix < 4) {
+		for (int i = 0; i < 2; ++i) {
+			if (instr.operands[i].type == OperandType::EffectiveAddress || instr.operands[i].type == OperandType::DirectAccess) {
+				instr.operands[i].seg_prefix = state.sr_prefix;
+				break;
+			}
 		}
+		state.sr_prefix = 0xff;
+	}
 
-		switch (instr.type) {
-		case InstructionType::Esc:
-			handle_esc(source, instr);
-			break;
-		case InstructionType::Imm8:
-			handle_imm(source, instr, false);
-			break;
-		case InstructionType::NearProc:
-		case InstructionType::Imm16:
-			handle_imm(source, instr, true);
-			break;
-		case InstructionType::FixedPort:
-			handle_fixed_port(source, instr);
-			break;
-		case InstructionType::VariablePort:
-			handle_var_port(source, instr);
-			break;
-		case InstructionType::Reg:
-			handle_reg(source, instr);
-			break;
-		case InstructionType::RegMem:
-			handle_regmem(source, instr);
-			break;
-		case InstructionType::RegMem_Far:
-			handle_regmem(source, instr);
-			instr.flags.far = true;
-			break;
-		case InstructionType::Mem_Reg:
-			handle_mem_reg(source, instr);
-			break;
-		case InstructionType::RegMem_1:
-			handle_regmem_1(source, instr);
-			break;
-		case InstructionType::RegMem_CL:
-			handle_regmem_CL(source, instr);
-			break;
-		case InstructionType::Reg_Acc:
-			handle_reg_acc(source, instr);
-			break;
-		case InstructionType::SR:
-			handle_seg_reg(source, instr);
-			break;
-		case InstructionType::SR_RegMem:
-			handle_sr_regmem(source, instr);
+	if (state.locked) {
+		instr.flags.locked = true;
+		state.locked = false;
+	}
+
+	if (state.repeated) {
+		instr.flags.repeated = true;
+		state.repeated = false;
+	}
+}
+
+template <uint8_t Opcode, InstructionType Type, InstructionOpcode Op>
+bool decode_instr(const uint8_t *&source, Instruction &instr, DecodeState &state) {
+	instr.type = Type;
+	instr.opcode = Op;
+
+	if constexpr (Type == InstructionType::Esc) {
+		handle_esc(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Imm8) {
+		handle_imm(source, instr, false);
+	} else if constexpr (Type == InstructionType::NearProc || Type == InstructionType::Imm16) {
+		handle_imm(source, instr, true);
+	} else if constexpr (Type == InstructionType::FixedPort) {
+		handle_fixed_port(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::VariablePort) {
+		handle_var_port(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Reg) {
+		handle_reg(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::RegMem) {
+		handle_regmem(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::RegMem_Far) {
+		handle_regmem(source, instr, Opcode);
+		instr.flags.far = true;
+	} else if constexpr (Type == InstructionType::Mem_Reg) {
+		handle_mem_reg(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::RegMem_1) {
+		handle_regmem_1(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::RegMem_CL) {
+		handle_regmem_CL(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Reg_Acc) {
+		handle_reg_acc(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::SR) {
+		handle_seg_reg(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::SR_RegMem) {
+		handle_sr_regmem(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::SingleByte) {
+		++source;
+		if constexpr (Op == InstructionOpcode::lock) {
+			state.locked = true;
+			return false;
+		}
+		if constexpr (Op == InstructionOpcode::rep) {
+			state.repeated = true;
+			return false;
+		}
+	} else if constexpr (Type == InstructionType::StringManip) {
+		++source;
+		instr.flags.wide = (Opcode & W_MASK);
+		instr.flags.string_op = true;
+	} else if constexpr (Type == InstructionType::SkipSecond) {
+		source += 2;
+	} else if constexpr (Type == InstructionType::RegMem_Reg) {
+		handle_regmem_reg(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Imm_RegMem) {
+		handle_imm_regmem(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Imm_RegMem_SE) {
+		handle_imm_regmem(source, instr, Opcode, true);
+	} else if constexpr (Type == InstructionType::Imm_Reg) {
+		handle_imm_reg(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Mem_Acc) {
+		handle_mem_acc(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Acc_Mem) {
+		handle_acc_mem(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Imm_Acc) {
+		handle_imm_acc(source, instr, Opcode);
+	} else if constexpr (Type == InstructionType::Jmp) {
+		handle_jmp(source, instr);
+	} else if constexpr (Type == InstructionType::FarProc) {
+		handle_far_proc(source, instr);
+	} else if constexpr (Type == InstructionType::SegmentPrefix) {
+		++source;
+		state.sr_prefix = (Opcode & SR_MASK) >> 3;
+		return false;
+	} else {
+		static_assert(Type != Type, "Instruction type not handled by decode_instr!");
+	}
+
+	return true;
+}
+
+bool decode_unknown(const uint8_t *&, Instruction &, DecodeState &state) {
+	state.unknown = true;
+	return false;
+}
+
+template <uint8_t Opcode, int Row>
+bool decode_special(const uint8_t *&source, Instruction &instr, DecodeState &state);
+
+#include "scripts/instr_decode_table.inl"
+
+template <uint8_t Opcode, int Row>
+bool decode_special(const uint8_t *&source, Instruction &instr, DecodeState &state) {
+	const uint8_t reg = (*(source + 1) & SB_REG_MASK) >> 3;
+	return special_decode_table[Row][reg](source, instr, state);
+}
+
+std::size_t decode_instruction(const uint8_t *source, std::size_t source_size, Instruction &instr) {
+	const uint8_t *cur = source;
+	DecodeState state;
+	while (cur < source + source_size) {
+		instr = Instruction{};
+		if (decode_table[*cur](cur, instr, state)) {
+			finish_instr(instr, state);
+			const std::size_t length = cur - source;
+			return length <= source_size ? length : 0;
+		}
+		if (state.unknown) {
 			break;
-		case InstructionType::SingleByte:
-			++source;
-			if (instr.opcode == InstructionOpcode::lock) {
-				locked = true;
-				continue;
-			}
-			if (instr.opcode == InstructionOpcode::rep) {
-				repeated = true;
-				continue;
+		}
+	}
+
+	return 0;
+}
+
+struct DecodeRangeResult {
+	std::size_t end; // offset right after the last decoded instruction
+	bool unknown; // stopped at an unknown opcode at end
+};
+
+/**
+ * Decodes every instruction starting (with its prefixes) in [begin, end)
+ * and appends them and their start offsets to instrs and offsets.
+ * The last instruction may extend past end.
+ */
+DecodeRangeResult decode_range(const uint8_t *source, std::size_t source_size, std::size_t begin, std::size_t end,
+	std::vector<Instruction> &instrs, std::vector<uint32_t> &offsets) {
+	const uint8_t *cur = source + begin;
+	const uint8_t *instr_start = cur;
+
+	// Instructions are decoded into a small local block which is appended
+	// to instrs once full, so the hot loop doesn't go through push_back.
+	constexpr int BLOCK_SIZE = 256;
+	Instruction block[BLOCK_SIZE];
+	int count = 0;
+
+	DecodeState state;
+	while (cur < source + source_size && instr_start < source + end) {
+		Instruction &instr = block[count];
+		instr = Instruction{};
+		if (!decode_table[*cur](cur, instr, state)) {
+			if (state.unknown) {
+				break;
 			}
-			break;
-		case InstructionType::StringManip:
-			++source;
-			instr.flags.wide = (opcode & W_MASK);
-			instr.flags.string_op = true;
-			break;
-		case InstructionType::SkipSecond:
-			source += 2;
-			break;
-		case InstructionType::RegMem_Reg:
-			handle_regmem_reg(source, instr);
-			break;
-		case InstructionType::Imm_RegMem:
-			handle_imm_regmem(source, instr);
-			break;
-		case InstructionType::Imm_RegMem_SE:
-			handle_imm_regmem(source, instr, true);
-			break;
-		case InstructionType::Imm_Reg:
-			handle_imm_reg(source, instr);
-			break;
-		case InstructionType::Mem_Acc:
-			handle_mem_acc(source, instr);
-			break;
-		case InstructionType::Acc_Mem:
-			handle_acc_mem(source, instr);
-			break;
-		case InstructionType::Imm_Acc:
-			handle_imm_acc(source, instr);
-			break;
-		case InstructionType::Jmp:
-			handle_jmp(source, instr);
-			break;
-		case InstructionType::FarProc:
-			handle_far_proc(source, instr);
-			break;
-		case InstructionType::SegmentPrefix:
-			++source;
-			sr_prefix = (opcode & SR_MASK) >> 3;
 			continue;
-			break;
-		default:
-			fprintf(STREAM_OUT, "instruction not supported! Type: %d Idx: %llu\n", static_cast<int>(instr.type), decoded.size());
-			exit(1);
-			break; // just in case
 		}
 
-		if (instr.operands[1].type != OperandType::None && instr.flags.dest) {
-			std::swap(instr.operands[0], instr.operands[1]);
-			instr.flags.dest = false;
+		finish_instr(instr, state);
+		offsets.push_back(static_cast<uint32_t>(instr_start - source));
+		instr_start = cur;
+		if (++count == BLOCK_SIZE) {
+			instrs.insert(instrs.end(), block, block + count);
+			count = 0;
 		}
+	}
 
-		if (sr_prefix < 4) {
-			for (int i = 0; i < 2; ++i) {
-				if (instr.operands[i].type == OperandType::EffectiveAddress || instr.operands[i].type == OperandType::DirectAccess) {
-					instr.operands[i].seg_prefix = sr_prefix;
-					sr_prefix = 0xff;
-				}
-			}
+	instrs.insert(instrs.end(), block, block + count);
+
+	return { static_cast<std::size_t>(instr_start - source), state.unknown };
+}
+
+/**
+ * Output of decode_range run speculatively on a chunk whose start
+ * is not known to be an instruction boundary.
+ */
+struct DecodedChunk {
+	std::vector<Instruction> instrs;
+	std::vector<uint32_t> offsets;
+	DecodeRangeResult res;
+};
+
+/**
+ * Appends the instructions of chunk starting at pos, which is the true end
+ * of the previous chunk. Until pos lands on a boundary speculative decoding
+ * also found we decode instruction by instruction.
+ */
+DecodeRangeResult resync_chunk(const uint8_t *source, std::size_t source_size, std::size_t pos, std::size_t end, const DecodedChunk &chunk,
+	std::vector<Instruction> &decoded, std::vector<uint32_t> &decoded_offsets) {
+	auto it = std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), pos);
+	DecodeRangeResult res = { pos, false };
+	while (res.end < end && (it == chunk.offsets.end() || *it != res.end)) {
+		res = decode_range(source, source_size, res.end, res.end + 1, decoded, decoded_offsets);
+		if (res.unknown) {
+			return res;
+		}
+		it = std::lower_bound(it, chunk.offsets.end(), res.end);
+	}
+
+	if (res.end >= end) {
+		return res;
+	}
+
+	const std::size_t idx = it - chunk.offsets.begin();
+	decoded.insert(decoded.end(), chunk.instrs.begin() + idx, chunk.instrs.end());
+	decoded_offsets.insert(decoded_offsets.end(), chunk.offsets.begin() + idx, chunk.offsets.end());
+
+	return chunk.res;
+}
+
+void Decoder::collect_labels(std::size_t first) {
+	PROFILE_FUNCTION;
+	const std::size_t old_count = labels.size();
+
+	for (std::size_t i = first; i < decoded.size(); ++i) {
+		if (decoded[i].operands[0].type != OperandType::Label) {
+			continue;
 		}
 
-		if (locked) {
-			instr.flags.locked = true;
-			locked = false;
+		const uint32_t next = i + 1 < offsets.size() ? offsets[i + 1] : code_size;
+		const int64_t target = int64_t(next) + decoded[i].operands[0].jmp_offset;
+		if (target == code_size || (target >= 0 && std::binary_search(offsets.begin(), offsets.end(), uint32_t(target)))) {
+			labels.push_back(uint32_t(target));
 		}
+	}
+
+	std::sort(labels.begin() + old_count, labels.end());
+	std::inplace_merge(labels.begin(), labels.begin() + old_count, labels.end());
+	labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+}
+
+std::uint32_t Decoder::next_offset(std::size_t idx) const {
+	return idx + 1 < offset_view.size() ? offset_view[idx + 1] : code_size;
+}
+
+void Decoder::update_views() {
+	instr_view = decoded;
+	offset_view = offsets;
+	label_view = labels;
+}
+
+bool Decoder::decode(const uint8_t *source, std::size_t source_size, unsigned thread_count) {
+	PROFILE_COUNTERS("decode", source_size);
+	if (cache) {
+		// Appending to a loaded cache, take a copy we can grow.
+		decoded.assign(instr_view.begin(), instr_view.end());
+		offsets.assign(offset_view.begin(), offset_view.end());
+		labels.assign(label_view.begin(), label_view.end());
+		cache.reset();
+	}
+
+	const std::size_t first = decoded.size();
+	const uint32_t base = code_size;
+
+	if (thread_count == 0) {
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+	const std::size_t chunk_count = std::clamp<std::size_t>(source_size / MIN_CHUNK_SIZE, 1, thread_count);
+	const std::size_t chunk_size = source_size / chunk_count;
+
+	DecodeRangeResult res;
+	if (chunk_count == 1) {
+		// Length pass is several times faster than decoding, cheaper than
+		// letting decoded grow.
+		decoded.reserve(decoded.size() + decode_lengths(source, source_size));
+		offsets.reserve(decoded.capacity());
+
+		res = decode_range(source, source_size, 0, source_size, decoded, offsets);
+	} else {
+		// Every chunk but the first starts decoding at a guessed boundary.
+		// 8086 code resynchronizes within a few instructions so most of the
+		// speculative work is kept once we know where the previous chunk ended.
+		std::vector<DecodedChunk> chunks(chunk_count);
+		std::vector<std::thread> workers;
+		for (std::size_t i = 1; i < chunk_count; ++i) {
+			workers.emplace_back([&, i]() {
+				const std::size_t begin = i * chunk_size;
+				const std::size_t end = (i + 1 == chunk_count) ? source_size : begin + chunk_size;
+				DecodedChunk &chunk = chunks[i];
+				chunk.instrs.reserve(decode_lengths(source + begin, end - begin));
+				chunk.offsets.reserve(chunk.instrs.capacity());
+				chunk.res = decode_range(source, source_size, begin, end, chunk.instrs, chunk.offsets);
+			});
+		}
+
+		decoded.reserve(decoded.size() + decode_lengths(source, chunk_size));
+		res = decode_range(source, source_size, 0, chunk_size, decoded, offsets);
+
+		for (auto &worker : workers) {
+			worker.join();
+		}
+
+		std::size_t total = decoded.size();
+		for (auto &chunk : chunks) {
+			total += chunk.instrs.size();
+		}
+		decoded.reserve(total);
+		offsets.reserve(total);
+
+		for (std::size_t i = 1; i < chunk_count && !res.unknown; ++i) {
+			const std::size_t end = (i + 1 == chunk_count) ? source_size : (i + 1) * chunk_size;
+			res = resync_chunk(source, source_size, res.end, end, chunks[i], decoded, offsets);
+		}
+	}
+
+	// Offsets are relative to this source, keep them unique across calls.
+	for (std::size_t i = first; i < offsets.size(); ++i) {
+		offsets[i] += base;
+	}
+	code_size = base + static_cast<uint32_t>(res.end);
+
+	collect_labels(first);
+	update_views();
+
+	return !res.unknown;
+}
 
-		if (repeated) {
-			instr.flags.repeated = true;
-			repeated = false;
+std::size_t decode_lengths(const uint8_t *source, std::size_t source_size, std::vector<uint32_t> *offsets) {
+	std::size_t count = 0;
+	std::size_t start = 0;
+	bool prefixed = false;
+
+	std::size_t pos = 0;
+	while (pos < source_size) {
+		const uint8_t opcode = source[pos];
+		const InstrLength info = instr_lengths[opcode];
+		if (info.flags & LENGTH_PREFIX) {
+			start = prefixed ? start : pos;
+			prefixed = true;
+			++pos;
+			continue;
 		}
 
-		decoded.push_back(instr);
-		//print_instr(instr, decoded.size() - 1);
+		start = prefixed ? start : pos;
+		prefixed = false;
+		if (offsets) {
+			offsets->push_back(static_cast<uint32_t>(start));
+		}
+		++count;
+
+		const uint8_t modrm = source[pos + 1];
+		const bool has_modrm = (info.flags & LENGTH_MODRM);
+		const bool group_imm = (info.flags & LENGTH_GROUP_IMM) && (modrm & SB_REG_MASK) == 0;
+		pos += info.size;
+		pos += has_modrm * modrm_table[modrm].disp_size;
+		pos += group_imm * (1 + (opcode & W_MASK));
 	}
+
+	return count;
 }
 
-std::vector<Instruction> &get_decoded_instructions() {
-	return decoded;
+std::span<const Instruction> Decoder::instructions() const {
+	return instr_view;
 }
 
-void print_operand(const Operand &op, bool wide, std::size_t idx, bool print_width_specifier, bool snd = false) {
+std::span<const std::uint32_t> Decoder::instruction_offsets() const {
+	return offset_view;
+}
+
+std::size_t Decoder::find_instruction(std::uint32_t offset) const {
+	auto it = std::lower_bound(offset_view.begin(), offset_view.end(), offset);
+	if (it == offset_view.end() || *it != offset) {
+		return instr_view.size();
+	}
+
+	return it - offset_view.begin();
+}
+
+struct JumpContext {
+	std::span<const uint32_t> labels; // sorted label offsets
+	int64_t next_offset = -1; // offset of the following instruction, -1 if unknown
+	int64_t instr_offset = -1; // if set jumps are printed as $+n relative to it instead of labels
+};
+
+void print_operand(AsmWriter &out, const JumpContext &jump, const Operand &op, bool wide, bool print_width_specifier, bool snd = false) {
 	if (op.type == OperandType::None) {
 		return;
 	}
 
-	fprintf(STREAM_OUT, "%s ", snd ? "," : "");
+	out.put(snd ? ", " : " ");
 
-	char specifier[5] = { '\0' };
-	int len = sprintf(specifier, "%s", wide ? "word" : "byte");
-	specifier[4] = '\0';
+	const std::string_view specifier = wide ? "word " : "byte ";
 
 	switch (op.type) {
 	case OperandType::Immediate:
-		fprintf(STREAM_OUT, "%d", op.imm_value);
+		out.put_int(op.imm_value);
 		break;
 	case OperandType::EffectiveAddress:
 		if (print_width_specifier) {
-			fprintf(STREAM_OUT, "%s ", specifier);
+			out.put(specifier);
 		}
 		if (op.seg_prefix != 0xff) {
-			fprintf(STREAM_OUT, "%s:", sr_to_str[op.seg_prefix]);
+			out.put(sr_to_str[op.seg_prefix]);
+			out.put(':');
 		}
-		fprintf(STREAM_OUT, "[%s", eff_addr_to_str[static_cast<int>(op.eff_addr)]);
+		out.put('[');
+		out.put(eff_addr_to_str[static_cast<int>(op.eff_addr)]);
 		if (op.displacement > 0) {
-			fprintf(STREAM_OUT, " + %d", op.displacement);
+			out.put(" + ");
+			out.put_int(op.displacement);
 		}
 		if (op.displacement < 0) {
-			fprintf(STREAM_OUT, " - %d", bitwise_abs(op.displacement));
+			out.put(" - ");
+			out.put_int(bitwise_abs(op.displacement));
 		}
-		fprintf(STREAM_OUT, "]");
+		out.put(']');
 		break;
 	case OperandType::DirectAccess:
 		if (print_width_specifier) {
-			fprintf(STREAM_OUT, "%s ", specifier);
+			out.put(specifier);
 		}
 		if (op.seg_prefix != 0xff) {
-			fprintf(STREAM_OUT, "%s:", sr_to_str[op.seg_prefix]);
+			out.put(sr_to_str[op.seg_prefix]);
+			out.put(':');
 		}
-		fprintf(STREAM_OUT, "[%d]", op.direct_access);
+		out.put('[');
+		out.put_int(op.direct_access);
+		out.put(']');
 		break;
 	case OperandType::Register:
-		fprintf(STREAM_OUT, "%s", reg_to_str[static_cast<int>(op.reg)]);
+		out.put(reg_to_str[static_cast<int>(op.reg)]);
 		break;
 	case OperandType::SegmentRegister:
-		fprintf(STREAM_OUT, "%s", sr_to_str[static_cast<int>(op.seg_reg)]);
+		out.put(sr_to_str[static_cast<int>(op.seg_reg)]);
 		break;
 	case OperandType::Accumulator:
-		fprintf(STREAM_OUT, "%s", wide ? "ax" : "al");
+		out.put(wide ? "ax" : "al");
 		break;
 	case OperandType::Label:
 	{
-		int instr_offset = (op.jmp_offset >> 1);
-		std::size_t line = idx + instr_offset;
-		if (auto it = labels.find(line); it != labels.end()) {
-			fprintf(STREAM_OUT, "label%d", it->second);
+		const int64_t target = jump.next_offset + op.jmp_offset;
+		auto it = std::lower_bound(jump.labels.begin(), jump.labels.end(), target);
+		if (jump.instr_offset >= 0) {
+			out.put(target >= jump.instr_offset ? "$+" : "$");
+			out.put_int(target - jump.instr_offset);
+		} else if (target >= 0 && it != jump.labels.end() && *it == target) {
+			out.put("label");
+			out.put_int(it - jump.labels.begin());
 		} else {
-			fprintf(STREAM_OUT, "LABEL_NOT_FOUND");
+			out.put("LABEL_NOT_FOUND");
 		}
 
 		break;
 	}
 	case OperandType::FarProc:
-		fprintf(STREAM_OUT, "%d:%d", op.far_proc_cs, op.far_proc_ip);
+		out.put_int(op.far_proc_cs);
+		out.put(':');
+		out.put_int(op.far_proc_ip);
 		break;
 	case OperandType::None:
 		break;
 	}
 }
 
-void print_instr(const Instruction &instr, std::size_t idx) {
+void print_instr(AsmWriter &out, const JumpContext &jump, const Instruction &instr) {
 	auto &op0 = instr.operands[0];
 	auto &op1 = instr.operands[1];
 
 	bool width_specifier = (instr.opcode != InstructionOpcode::call && instr.opcode != InstructionOpcode::jmp);
 
-	fprintf(STREAM_OUT, "%s%s%s%s%s",
-		(instr.flags.locked ? "lock " : ""),
-		(instr.flags.repeated ? "rep " : ""),
-		instr.name.c_str(),
-		(instr.flags.string_op ? (instr.flags.wide ? "w" : "b") : ""),
-		(instr.flags.far && instr.operands[0].type != OperandType::FarProc ? " far " : "")
-	);
-	print_operand(op0, instr.flags.wide, idx, (op1.type == OperandType::Immediate || op1.type == OperandType::None) && width_specifier);
-	print_operand(op1, instr.flags.wide, idx, op0.type == OperandType::Immediate && width_specifier, true);
+	out.reserve();
+	if (instr.flags.locked) {
+		out.put("lock ");
+	}
+	if (instr.flags.repeated) {
+		out.put("rep ");
+	}
+	out.put(instr_opcode_names[static_cast<int>(instr.opcode)]);
+	if (instr.flags.string_op) {
+		out.put(instr.flags.wide ? 'w' : 'b');
+	}
+	if (instr.flags.far && instr.operands[0].type != OperandType::FarProc) {
+		out.put(" far ");
+	}
+	print_operand(out, jump, op0, instr.flags.wide, (op1.type == OperandType::Immediate || op1.type == OperandType::None) && width_specifier);
+	print_operand(out, jump, op1, instr.flags.wide, op0.type == OperandType::Immediate && width_specifier, true);
+}
+
+void print_label(AsmWriter &out, std::size_t label) {
+	out.reserve();
+	out.put("label");
+	out.put_int(label);
+	out.put(":\n");
+}
+
+void print_instr(const Instruction &instr, FILE *out) {
+	AsmWriter writer(out, AsmWriter::MAX_LINE);
+	print_instr(writer, JumpContext{}, instr);
+}
+
+void print_instr(const Instruction &instr, std::uint32_t offset, std::uint32_t length, FILE *out) {
+	AsmWriter writer(out, AsmWriter::MAX_LINE);
+	print_instr(writer, JumpContext{ {}, int64_t(offset) + length, offset }, instr);
+}
+
+void Decoder::print_instr(const Instruction &instr, std::size_t idx, FILE *out) const {
+	AsmWriter writer(out, AsmWriter::MAX_LINE);
+	emu8086::print_instr(writer, JumpContext{ label_view, next_offset(idx) }, instr);
+}
+
+void Decoder::print_range(AsmWriter &out, std::size_t begin, std::size_t end) const {
+	// labels and offsets are both sorted, so walk them together
+	std::size_t label = begin < offset_view.size()
+		? std::lower_bound(label_view.begin(), label_view.end(), offset_view[begin]) - label_view.begin()
+		: label_view.size();
+	for (std::size_t i = begin; i < end; ++i) {
+		for (; label < label_view.size() && label_view[label] <= offset_view[i]; ++label) {
+			print_label(out, label);
+		}
+
+		emu8086::print_instr(out, JumpContext{ label_view, next_offset(i) }, instr_view[i]);
+		out.put('\n');
+	}
+
+	if (end == instr_view.size()) {
+		for (; label < label_view.size(); ++label) {
+			print_label(out, label);
+		}
+	}
+}
+
+void Decoder::print_asm(FILE *out, unsigned thread_count) const {
+	PROFILE_COUNTERS("print_asm", 0);
+	if (thread_count == 0) {
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	if (thread_count == 1 || instr_view.size() <= PRINT_BLOCK_SIZE) {
+		AsmWriter writer(out);
+		writer.put("bits 16\n");
+		print_range(writer, 0, instr_view.size());
+		return;
+	}
+
+	// Blocks of instructions go to formatting workers through a bounded
+	// queue, formatted text comes back in whatever order the workers finish
+	// and the writer puts it back in order. Both queues being bounded caps
+	// how far formatting can run ahead of the output.
+	struct Block {
+		std::size_t idx;
+		std::string text;
+	};
+
+	const std::size_t block_count = (instr_view.size() + PRINT_BLOCK_SIZE - 1) / PRINT_BLOCK_SIZE;
+	BoundedQueue<std::size_t> jobs(2 * thread_count);
+	BoundedQueue<Block> results(2 * thread_count);
+
+	std::thread writer([&]() {
+		fwrite("bits 16\n", 1, 8, out);
+
+		std::map<std::size_t, std::string> pending;
+		std::size_t next = 0;
+		while (next < block_count) {
+			std::optional<Block> block = results.pop();
+			if (!block) {
+				break;
+			}
+			pending.emplace(block->idx, std::move(block->text));
+
+			for (auto it = pending.begin(); it != pending.end() && it->first == next; it = pending.erase(it), ++next) {
+				fwrite(it->second.data(), 1, it->second.size(), out);
+			}
+		}
+	});
+
+	std::vector<std::thread> workers;
+	for (unsigned i = 0; i < thread_count; ++i) {
+		workers.emplace_back([&]() {
+			while (std::optional<std::size_t> idx = jobs.pop()) {
+				Block block{ *idx, {} };
+				{
+					AsmWriter text(block.text);
+					const std::size_t begin = *idx * PRINT_BLOCK_SIZE;
+					print_range(text, begin, std::min(begin + PRINT_BLOCK_SIZE, instr_view.size()));
+				}
+				results.push(std::move(block));
+			}
+		});
+	}
+
+	for (std::size_t i = 0; i < block_count; ++i) {
+		jobs.push(i);
+	}
+	jobs.close();
+
+	for (auto &worker : workers) {
+		worker.join();
+	}
+	writer.join();
+}
 
-	// print label if necessary
-	if (auto it = labels.find(idx); it != labels.end()) {
-		fprintf(STREAM_OUT, "\nlabel%s:", std::to_string(it->second).c_str());
+/**
+ * Returns the offset right after the last instruction that fits
+ * completely in size bytes. Prefixes count as part of their instruction.
+ */
+static std::size_t complete_length(const uint8_t *source, std::size_t size) {
+	std::size_t start = 0;
+	std::size_t pos = 0;
+	while (pos < size) {
+		const uint8_t opcode = source[pos];
+		const InstrLength info = instr_lengths[opcode];
+		if (info.flags & LENGTH_PREFIX) {
+			++pos;
+			continue;
+		}
+
+		const uint8_t modrm = source[pos + 1];
+		const bool has_modrm = (info.flags & LENGTH_MODRM);
+		const bool group_imm = (info.flags & LENGTH_GROUP_IMM) && (modrm & SB_REG_MASK) == 0;
+		std::size_t next = pos + info.size;
+		next += has_modrm * modrm_table[modrm].disp_size;
+		next += group_imm * (1 + (opcode & W_MASK));
+		// modrm may not have arrived yet, in which case next is a guess
+		if (next > size || (has_modrm && pos + 1 >= size)) {
+			break;
+		}
+
+		pos = next;
+		start = pos;
 	}
 
+	return start;
+}
+
+StreamDecoder::StreamDecoder(std::size_t buffer_size)
+	: buffer(new uint8_t[buffer_size + DECODE_PADDING]()), buffer_size(buffer_size) {
 }
 
-void print_asm() {
-	fprintf(STREAM_OUT, "bits 16\n");
+bool StreamDecoder::decode(FILE *in, FILE *out) {
+	AsmWriter writer(out);
+	writer.put("bits 16\n");
+
+	std::vector<Instruction> instrs;
+	std::vector<uint32_t> offsets;
+
+	std::size_t used = 0;
+	bool eof = false;
+	while (!eof || used > 0) {
+		// Whatever is available is decoded right away, a pipe may not
+		// deliver more for a while.
+		if (!eof && used < buffer_size) {
+			const std::size_t bytes_read = read_some(in, buffer.get() + used, buffer_size - used);
+			eof = bytes_read == 0;
+			used += bytes_read;
+		}
+
+		// Bytes after the data must look like the zero padding a whole-file
+		// decode would see, in case the input ends mid-instruction.
+		std::memset(buffer.get() + used, 0, DECODE_PADDING);
+
+		std::size_t complete = eof ? used : complete_length(buffer.get(), used);
+		if (complete == 0 && !eof) {
+			if (used < buffer_size) {
+				continue;
+			}
+			// Buffer is full of prefixes, nothing more can fit
+			complete = used;
+		}
 
-	for (std::size_t i = 0; i < decoded.size(); ++i) {
-		auto &instr = decoded[i];
+		instrs.clear();
+		offsets.clear();
+		const DecodeRangeResult res = decode_range(buffer.get(), complete, 0, complete, instrs, offsets);
 
-		print_instr(instr, i);
-		fprintf(STREAM_OUT, "\n");
+		for (std::size_t i = 0; i < instrs.size(); ++i) {
+			const int64_t next = i + 1 < offsets.size() ? offsets[i + 1] : res.end;
+			print_instr(writer, JumpContext{ {}, next, offsets[i] }, instrs[i]);
+			writer.put('\n');
+		}
+		writer.flush();
+		fflush(out);
+
+		decoded_count += instrs.size();
+
+		if (res.unknown) {
+			return false;
+		}
+
+		// At the end a truncated instruction was decoded into the padding,
+		// so res.end can be past the data.
+		if (eof) {
+			break;
+		}
+
+		// Carry a partial instruction over to the next refill.
+		used -= res.end;
+		std::memmove(buffer.get(), buffer.get() + res.end, used);
 	}
+
+	return true;
+}
+
+std::size_t StreamDecoder::read_some(FILE *in, uint8_t *dest, std::size_t size) {
+#ifdef _WIN32
+	const int res = _read(_fileno(in), dest, static_cast<unsigned>(std::min<std::size_t>(size, INT_MAX)));
+#else
+	const ssize_t res = ::read(fileno(in), dest, size);
+#endif
+	return res > 0 ? static_cast<std::size_t>(res) : 0;
+}
+
+std::size_t StreamDecoder::count() const {
+	return decoded_count;
 }
 
 }
@@ -1,19 +1,152 @@
 #pragma once
 
 #include "emu8086.h"
+#include "input_file.h"
 #include "instructions.h"
 
+#include <cstdio>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace emu8086 {
 
+class AsmWriter;
+
+/**
+ * Number of readable bytes the decoder expects after the end of its input.
+ * Lets it read displacements and immediates with single wide loads.
+ */
+constexpr std::size_t DECODE_PADDING = 16;
+
+/**
+ * Inputs are split in chunks of at least this size for parallel decoding.
+ */
+constexpr std::size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+/**
+ * Number of instructions formatted as one unit by a parallel print_asm().
+ */
+constexpr std::size_t PRINT_BLOCK_SIZE = 16 * 1024;
+
+/**
+ * Finds instruction boundaries without building any Instruction.
+ * Appends start offset of each instruction (including its prefixes)
+ * to offsets if given. Unknown opcodes count as 1 byte instructions.
+ * source must be readable for source_size + DECODE_PADDING bytes.
+ * @return number of instructions
+ */
+std::size_t decode_lengths(const std::uint8_t *source, std::size_t source_size, std::vector<std::uint32_t> *offsets = nullptr);
+
+/**
+ * Decodes the single instruction (with its prefixes) starting at source.
+ * source must be readable for source_size + DECODE_PADDING bytes.
+ * @return length in bytes, 0 if the opcode is unknown or the instruction doesn't fit in source_size.
+ */
+std::size_t decode_instruction(const std::uint8_t *source, std::size_t source_size, Instruction &instr);
+
+/**
+ * Prints a single instruction. Jump targets can't be resolved without
+ * the rest of the program so they are printed as LABEL_NOT_FOUND.
+ */
+void print_instr(const Instruction &instr, FILE *out = STREAM_OUT);
+
 /**
- * @breif Output disassembled binary instructions to std output as asm
+ * Prints a single instruction found at offset, jumps are printed relative to it as $+n.
  */
-void decode(const std::uint8_t *source, std::size_t source_size);
+void print_instr(const Instruction &instr, std::uint32_t offset, std::uint32_t length, FILE *out = STREAM_OUT);
+
+/**
+ * Owns the instructions and labels decoded from one binary, so
+ * several binaries can be decoded at the same time.
+ */
+class Decoder {
+public:
+	/**
+	 * @breif Decodes source and appends the instructions to instructions()
+	 * source must be readable for source_size + DECODE_PADDING bytes.
+	 * Large inputs are decoded in chunks on up to thread_count threads,
+	 * 0 means one per hardware thread. Result is the same as decoding serially.
+	 * @return false if decoding stopped at an unsupported instruction.
+	 */
+	bool decode(const std::uint8_t *source, std::size_t source_size, unsigned thread_count = 1);
+
+	std::span<const Instruction> instructions() const;
+
+	/**
+	 * Byte offset of every instruction (including its prefixes), sorted.
+	 */
+	std::span<const std::uint32_t> instruction_offsets() const;
+
+	/**
+	 * @return index of the instruction starting at offset or instructions().size() if none does.
+	 */
+	std::size_t find_instruction(std::uint32_t offset) const;
+
+	void print_instr(const Instruction &instr, std::size_t idx, FILE *out = STREAM_OUT) const;
+	/**
+	 * Formats blocks of PRINT_BLOCK_SIZE instructions on up to thread_count
+	 * threads, 0 means one per hardware thread. Output doesn't depend on it.
+	 */
+	void print_asm(FILE *out = STREAM_OUT, unsigned thread_count = 1) const;
+
+	/**
+	 * Writes instructions, offsets and labels to a decode cache file,
+	 * see decode_cache.h. input_hash is hash_input() of the decoded input.
+	 */
+	bool save_cache(const char *path, std::uint64_t input_hash, std::size_t input_size) const;
+
+	/**
+	 * Replaces the decoder contents with a decode cache file, which is mapped
+	 * and used in place. Fails if the file is not a cache of this version
+	 * or was written for a different input.
+	 */
+	bool load_cache(const char *path, std::uint64_t input_hash, std::size_t input_size);
+
+private:
+	void collect_labels(std::size_t first);
+	std::uint32_t next_offset(std::size_t idx) const;
+	void print_range(AsmWriter &out, std::size_t begin, std::size_t end) const;
+	void update_views();
+
+	std::vector<Instruction> decoded;
+	std::vector<std::uint32_t> offsets;
+	std::vector<std::uint32_t> labels; // sorted unique jump targets
+	std::uint32_t code_size = 0;
+
+	// Everything reads through these, they point either into the vectors
+	// above or into a mapped cache file.
+	std::span<const Instruction> instr_view;
+	std::span<const std::uint32_t> offset_view;
+	std::span<const std::uint32_t> label_view;
+	std::unique_ptr<InputFile> cache;
+};
+
+/**
+ * Decodes a stream such as stdin or a pipe and prints instructions as soon
+ * as they are complete, keeping memory bounded by the buffer size.
+ * Labels can't be known in advance so jumps are printed relative, as $+n.
+ */
+class StreamDecoder {
+public:
+	explicit StreamDecoder(std::size_t buffer_size = 64 * 1024);
+
+	/**
+	 * @return false if decoding stopped at an unsupported instruction.
+	 */
+	bool decode(FILE *in, FILE *out = STREAM_OUT);
+
+	/**
+	 * Number of instructions decoded so far.
+	 */
+	std::size_t count() const;
+
+private:
+	static std::size_t read_some(FILE *in, std::uint8_t *dest, std::size_t size);
 
-std::vector<Instruction> &get_decoded_instructions();
-void print_instr(const Instruction &instr, std::size_t idx = -1);
-void print_asm();
+	std::unique_ptr<std::uint8_t[]> buffer;
+	std::size_t buffer_size;
+	std::size_t decoded_count = 0;
+};
 
 }
\ No newline at end of file
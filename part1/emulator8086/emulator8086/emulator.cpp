@@ -3,198 +3,1002 @@
 #include "memory.h"
 
 #include "decoder.h"
+#include "alu.h"
+#include "block_cache.h"
+#include "profiler.h"
 
-#include <concepts>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+// Computed goto, define THREADED_DISPATCH=0 to dispatch with a switch instead
+#ifndef THREADED_DISPATCH
+#if defined(__GNUC__) || defined(__clang__)
+#define THREADED_DISPATCH 1
+#else
+#define THREADED_DISPATCH 0
+#endif
+#endif
 
 namespace emu8086 {
 
-void handle_mov(const Instruction &instr) {
-	uint16_t src_data = 0;
+uint32_t operand_address(const Operand &op) {
+	if (op.type == OperandType::DirectAccess) {
+		return direct_address(op.direct_access, op.seg_prefix);
+	}
+
+	return effective_address(op.eff_addr, op.displacement, op.seg_prefix);
+}
+
+/**
+ * Byte operands are returned zero extended
+ */
+uint16_t read_operand(const Operand &op, bool wide) {
+	const uint16_t width_mask = wide ? 0xFFFF : 0xFF;
 
-	switch (instr.operands[1].type) {
+	switch (op.type) {
 	case OperandType::Immediate:
-		src_data = instr.operands[1].imm_value;
-		break;
+		return op.imm_value & width_mask;
 	case OperandType::Register:
-		src_data = get_register_data(instr.operands[1].reg);
-		break;
+		return get_register_data(op.reg) & width_mask;
+	case OperandType::Accumulator:
+		return get_register_data(wide ? RegisterName::AX : RegisterName::AL) & width_mask;
 	case OperandType::SegmentRegister:
-		src_data = get_sr(instr.operands[1].seg_reg);
-		break;
+		return get_sr(op.seg_reg);
+	case OperandType::EffectiveAddress:
+	case OperandType::DirectAccess:
+		return read_memory(operand_address(op), wide);
 	default:
-		break;
+		return 0;
 	}
+}
 
-	switch (instr.operands[0].type) {
+void write_operand(const Operand &op, uint16_t data, bool wide) {
+	switch (op.type) {
 	case OperandType::Register:
-		set_register(instr.operands[0].reg, src_data);
+		set_register(op.reg, data);
+		break;
+	case OperandType::Accumulator:
+		set_register(wide ? RegisterName::AX : RegisterName::AL, data);
 		break;
 	case OperandType::SegmentRegister:
-		set_sr(instr.operands[0].seg_reg, src_data);
+		set_sr(op.seg_reg, data);
+		break;
+	case OperandType::EffectiveAddress:
+	case OperandType::DirectAccess:
+		write_memory(operand_address(op), data, wide);
 		break;
 	default:
 		break;
 	}
 }
 
-template <std::integral T>
-int popcount(T x) {
-#ifdef _MSC_VER
-	if constexpr (sizeof(x) <= 2) {
-		return __popcnt16(uint16_t(x));
-	} else if constexpr (sizeof(x) <= 4) {
-		return __popcnt(uint32_t(x));
-	} else {
-		return __popcnt64(uint64_t(x));
-	}
-#elif __GNUC__
-	return __builtin_popcount(uint32_t(res));
-#endif
+void handle_mov(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const uint16_t src_data = read_operand(instr.operands[1], instr.flags.wide);
+	write_operand(instr.operands[0], src_data, instr.flags.wide);
 }
 
-template <class T>
-concept BinaryOp = requires(T x, uint16_t v1, uint16_t v2) {
-	{ x(v1, v2) } -> std::same_as<uint16_t>;
+struct BinaryOpRes {
+	uint16_t dest;
+	uint16_t src;
 };
 
-bool check_parity(uint16_t res) {
-	int cnt = popcount(res);
+BinaryOpRes handle_artm_instr(const Instruction &instr) {
+	const uint16_t src_data = read_operand(instr.operands[1], instr.flags.wide);
+	const uint16_t dest_data = read_operand(instr.operands[0], instr.flags.wide);
 
-	return cnt % 2 == 0;
+	return { dest_data, src_data };
 }
 
-template <BinaryOp F>
-void manage_common_artm_flags(F op, uint16_t dest, uint16_t src, bool wide) {
-	uint16_t res = op(dest, src);
+void handle_add(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	auto data = handle_artm_instr(instr);
 
-	set_flag(Flag::ZF, res == 0);
-	uint16_t sign_mask = wide ? 0x8000 : 0x80;
-	set_flag(Flag::SF, res & sign_mask);
+	const uint16_t res = data.dest + data.src;
+	write_operand(instr.operands[0], res, instr.flags.wide);
+	set_lazy_flags(FlagOp::Add, data.dest, data.src, res, instr.flags.wide);
+}
+
+void handle_sub(const Instruction &instr, bool is_cmp = false) {
+	PROFILE_FUNCTION;
+	auto data = handle_artm_instr(instr);
 
-	// 8086 only checks parity of lowest byte
-	set_flag(Flag::PF, check_parity(res & 0xFF));
+	const uint16_t res = data.dest - data.src;
+	if (!is_cmp) {
+		write_operand(instr.operands[0], res, instr.flags.wide);
+	}
+	set_lazy_flags(FlagOp::Sub, data.dest, data.src, res, instr.flags.wide);
 }
 
-struct BinaryOpRes {
-	uint16_t dest;
-	uint16_t src;
-};
+void handle_cmp(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	handle_sub(instr, true);
+}
 
-template <BinaryOp F>
-BinaryOpRes handle_artm_instr(const Instruction &instr, F op) {
-	uint16_t src_data = 0;
-	switch (instr.operands[1].type) {
-	case OperandType::Immediate:
-		src_data = instr.operands[1].imm_value;
+void handle_adc(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	auto data = handle_artm_instr(instr);
+
+	const uint16_t res = data.dest + data.src + flags_set(Flag::CF);
+	write_operand(instr.operands[0], res, instr.flags.wide);
+	set_lazy_flags(FlagOp::Adc, data.dest, data.src, res, instr.flags.wide);
+}
+
+void handle_sbb(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	auto data = handle_artm_instr(instr);
+
+	const uint16_t res = data.dest - data.src - flags_set(Flag::CF);
+	write_operand(instr.operands[0], res, instr.flags.wide);
+	set_lazy_flags(FlagOp::Sbb, data.dest, data.src, res, instr.flags.wide);
+}
+
+/**
+ * and, or, xor and test
+ */
+void handle_logic(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	auto data = handle_artm_instr(instr);
+
+	uint16_t res = 0;
+	switch (instr.opcode) {
+	case InstructionOpcode::or_:
+		res = data.dest | data.src;
 		break;
-	case OperandType::Register:
-		src_data = get_register_data(instr.operands[1].reg);
+	case InstructionOpcode::xor_:
+		res = data.dest ^ data.src;
 		break;
 	default:
+		res = data.dest & data.src;
 		break;
 	}
 
-	uint16_t dest_data = 0;
-	switch (instr.operands[0].type) {
-	case OperandType::Register:
+	if (instr.opcode != InstructionOpcode::test) {
+		write_operand(instr.operands[0], res, instr.flags.wide);
+	}
+	set_lazy_flags(FlagOp::Logic, res, 0, res, instr.flags.wide);
+}
+
+void handle_inc_dec(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const Operand &op = instr.operands[0];
+	// inc/dec reg are only encoded for word registers
+	const bool wide = instr.flags.wide || (op.type == OperandType::Register && op.reg >= RegisterName::AX);
+	const uint16_t dest = read_operand(op, wide);
+
+	const bool inc = instr.opcode == InstructionOpcode::inc;
+	const uint16_t res = inc ? dest + 1 : dest - 1;
+	write_operand(op, res, wide);
+	set_lazy_flags(inc ? FlagOp::Inc : FlagOp::Dec, dest, 1, res, wide);
+}
+
+void handle_neg(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const uint16_t src = read_operand(instr.operands[0], instr.flags.wide);
+
+	const uint16_t res = 0 - src;
+	write_operand(instr.operands[0], res, instr.flags.wide);
+	set_lazy_flags(FlagOp::Sub, 0, src, res, instr.flags.wide);
+}
+
+void handle_not(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	write_operand(instr.operands[0], ~read_operand(instr.operands[0], instr.flags.wide), instr.flags.wide);
+}
+
+/**
+ * Shifts and rotates by 1 or cl. Shifts set CF OF SF ZF PF, rotates only CF and OF.
+ * A count of 0 changes nothing, the 8086 doesn't mask the count.
+ */
+void handle_shift(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const unsigned count = read_operand(instr.operands[1], false);
+	if (count == 0) {
+		return;
+	}
+
+	const bool wide = instr.flags.wide;
+	const unsigned bits = wide ? 16 : 8;
+	const uint32_t width_mask = wide ? 0xFFFF : 0xFF;
+	const uint32_t sign_bit = wide ? 0x8000 : 0x80;
+	const uint32_t value = read_operand(instr.operands[0], wide);
+
+	uint32_t res = value;
+	bool cf = flags_set(Flag::CF);
+	bool of = false;
+	bool rotate = false;
+	switch (instr.opcode) {
+	case InstructionOpcode::sal:
+		cf = count <= bits && ((value >> (bits - count)) & 1);
+		res = count < bits ? (value << count) & width_mask : 0;
+		of = ((res & sign_bit) != 0) != cf;
+		break;
+	case InstructionOpcode::shr:
+		cf = count <= bits && ((value >> (count - 1)) & 1);
+		res = count < bits ? value >> count : 0;
+		of = (value & sign_bit) != 0;
+		break;
+	case InstructionOpcode::sar:
+	{
+		const int32_t signed_value = wide ? int16_t(value) : int8_t(value);
+		const unsigned n = std::min(count, bits);
+		cf = (signed_value >> (n - 1)) & 1;
+		res = uint32_t(signed_value >> n) & width_mask;
+		break;
+	}
+	case InstructionOpcode::rol:
 	{
-		dest_data = get_register_data(instr.operands[0].reg);
+		const unsigned n = count % bits;
+		res = ((value << n) | (value >> (bits - n))) & width_mask;
+		cf = res & 1;
+		of = ((res & sign_bit) != 0) != cf;
+		rotate = true;
 		break;
 	}
+	case InstructionOpcode::ror:
+	{
+		const unsigned n = count % bits;
+		res = ((value >> n) | (value << (bits - n))) & width_mask;
+		cf = (res & sign_bit) != 0;
+		of = ((res ^ (res << 1)) & sign_bit) != 0;
+		rotate = true;
+		break;
+	}
+	case InstructionOpcode::rcl:
+		for (unsigned i = count % (bits + 1); i > 0; --i) {
+			const bool out = (res & sign_bit) != 0;
+			res = ((res << 1) | cf) & width_mask;
+			cf = out;
+		}
+		of = ((res & sign_bit) != 0) != cf;
+		rotate = true;
+		break;
+	case InstructionOpcode::rcr:
+		of = ((value & sign_bit) != 0) != cf;
+		for (unsigned i = count % (bits + 1); i > 0; --i) {
+			const bool out = res & 1;
+			res = (res >> 1) | (cf ? sign_bit : 0);
+			cf = out;
+		}
+		rotate = true;
+		break;
 	default:
 		break;
 	}
 
-	manage_common_artm_flags(op, dest_data, src_data, instr.flags.wide);
-	return { dest_data, src_data };
+	write_operand(instr.operands[0], uint16_t(res), wide);
+
+	const uint16_t values = (cf ? CF_BIT : 0) | (of ? OF_BIT : 0);
+	if (rotate) {
+		update_flags(CF_BIT | OF_BIT, values);
+	} else {
+		update_flags(ARITHMETIC_FLAGS, values | szp_flags(uint16_t(res), wide));
+	}
 }
 
-void handle_add(const Instruction &instr) {
-	auto op = [](uint16_t x, uint16_t y) { return uint16_t(x + y); };
-
-	auto data = handle_artm_instr(instr, op);
-
-	auto res = op(data.dest, data.src);
-	set_register(instr.operands[0].reg, res);
-
-	int32_t width_mask = instr.flags.wide ? 0xFFFF : 0xFF;
-	bool carry = data.dest + data.src > width_mask;
-	set_flag(Flag::CF, carry);
-	
-	uint16_t sign_bit = instr.flags.wide ? 0x8000 : 0x80;
-	uint16_t max_val = instr.flags.wide ? 0x7FFF : 0x7F;
-	uint16_t min_val = instr.flags.wide ? 0x8000 : 0x80;
-	bool overflow = (!(data.dest & sign_bit) && data.dest > uint16_t(max_val - data.src)) ||
-		((data.dest & sign_bit) && data.dest < uint16_t(min_val - data.src));
-	set_flag(Flag::OF, overflow);
-	
-	uint8_t dest_nimble = data.dest & 0xF;
-	uint8_t src_nimble = data.src & 0xF;
-	bool aux_carry = dest_nimble + src_nimble > 0xF;
-	set_flag(Flag::AF, aux_carry);
+/**
+ * mul and imul, CF and OF are set when the upper half of the result is needed
+ */
+void handle_mul(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const bool wide = instr.flags.wide;
+	const bool is_signed = instr.opcode == InstructionOpcode::imul;
+	const uint16_t src = read_operand(instr.operands[0], wide);
+
+	bool upper = false;
+	if (!wide) {
+		const uint8_t al = uint8_t(get_register_data(RegisterName::AL));
+		const uint16_t res = is_signed ? uint16_t(int8_t(al) * int8_t(src)) : uint16_t(al * src);
+		set_register(RegisterName::AX, res);
+		upper = is_signed ? int16_t(res) != int8_t(res) : (res >> 8) != 0;
+	} else {
+		const uint16_t ax = get_register_data(RegisterName::AX);
+		const uint32_t res = is_signed ? uint32_t(int32_t(int16_t(ax)) * int16_t(src)) : uint32_t(ax) * src;
+		set_register(RegisterName::AX, uint16_t(res));
+		set_register(RegisterName::DX, uint16_t(res >> 16));
+		upper = is_signed ? int32_t(res) != int16_t(res) : (res >> 16) != 0;
+	}
+
+	update_flags(CF_BIT | OF_BIT, upper ? CF_BIT | OF_BIT : 0);
 }
 
-void handle_sub(const Instruction &instr, bool is_cmp = false) {
-	auto op = [](uint16_t x, uint16_t y) { return uint16_t(x - y); };
+/**
+ * div and idiv
+ * @return false on a divide error, division by zero or a quotient that doesn't fit
+ */
+bool handle_div(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const bool wide = instr.flags.wide;
+	const bool is_signed = instr.opcode == InstructionOpcode::idiv;
+	const uint16_t src = read_operand(instr.operands[0], wide);
+	if (src == 0) {
+		return false;
+	}
 
-	auto data = handle_artm_instr(instr, op);
+	const uint16_t ax = get_register_data(RegisterName::AX);
+	if (!wide) {
+		if (is_signed) {
+			const int32_t quotient = int16_t(ax) / int8_t(src);
+			if (quotient > 127 || quotient < -127) {
+				return false;
+			}
+			set_register(RegisterName::AL, uint16_t(quotient));
+			set_register(RegisterName::AH, uint16_t(int16_t(ax) % int8_t(src)));
+		} else {
+			const uint32_t quotient = ax / src;
+			if (quotient > 0xFF) {
+				return false;
+			}
+			set_register(RegisterName::AL, uint16_t(quotient));
+			set_register(RegisterName::AH, uint16_t(ax % src));
+		}
 
-	uint32_t dest = data.dest;
-	uint32_t src = data.src;
+		return true;
+	}
 
-	auto res = op(data.dest, data.src);
-	if (!is_cmp) {
-		set_register(instr.operands[0].reg, res);
-	}
-	 
-	bool carry = data.src > data.dest;
-	set_flag(Flag::CF, carry);
-	
-	uint16_t sign_bit = instr.flags.wide ? 0x8000 : 0x80;
-	uint16_t max_val = instr.flags.wide ? 0x7FFF : 0x7F;
-	uint16_t min_val = instr.flags.wide ? 0x8000 : 0x80;
-	bool overflow = (!(data.dest & sign_bit) && data.dest > uint16_t(min_val + data.src)) ||
-		((data.dest & sign_bit) && data.dest < uint16_t(max_val + data.src));
-	set_flag(Flag::OF, overflow);
-	
-	uint8_t aux_carry = 0xF;
-	uint8_t dest_nimble = data.dest & aux_carry;
-	uint8_t src_nimble = data.src & aux_carry;
-	set_flag(Flag::AF, src_nimble > dest_nimble);
+	const uint32_t dividend = (uint32_t(get_register_data(RegisterName::DX)) << 16) | ax;
+	if (is_signed) {
+		const int64_t quotient = int64_t(int32_t(dividend)) / int16_t(src);
+		if (quotient > 32767 || quotient < -32767) {
+			return false;
+		}
+		set_register(RegisterName::AX, uint16_t(quotient));
+		set_register(RegisterName::DX, uint16_t(int64_t(int32_t(dividend)) % int16_t(src)));
+	} else {
+		const uint32_t quotient = dividend / src;
+		if (quotient > 0xFFFF) {
+			return false;
+		}
+		set_register(RegisterName::AX, uint16_t(quotient));
+		set_register(RegisterName::DX, uint16_t(dividend % src));
+	}
+
+	return true;
 }
 
-void handle_cmp(const Instruction &instr) {
-	handle_sub(instr, true);
+/**
+ * daa, das, aaa, aas, aam and aad. aam and aad always use base 10.
+ */
+void handle_bcd(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const uint8_t al = uint8_t(get_register_data(RegisterName::AL));
+	const uint8_t ah = uint8_t(get_register_data(RegisterName::AH));
+	const bool af = flags_set(Flag::AF);
+	const bool cf = flags_set(Flag::CF);
+	const bool low_adjust = (al & 0xF) > 9 || af;
+
+	switch (instr.opcode) {
+	case InstructionOpcode::daa:
+	case InstructionOpcode::das:
+	{
+		const bool add = instr.opcode == InstructionOpcode::daa;
+		uint8_t res = al;
+		bool carry = false;
+		if (low_adjust) {
+			carry = add ? res > 0xFF - 6 : res < 6;
+			res = add ? res + 6 : res - 6;
+		}
+		const bool high_adjust = al > 0x99 || cf;
+		if (high_adjust) {
+			res = add ? res + 0x60 : res - 0x60;
+		}
+		set_register(RegisterName::AL, res);
+		// A carry out of the low adjust only survives in das
+		const bool carry_out = high_adjust || (!add && carry);
+		update_flags(CF_BIT | AF_BIT | SF_BIT | ZF_BIT | PF_BIT,
+			(carry_out ? CF_BIT : 0) | (low_adjust ? AF_BIT : 0) | szp_flags(res, false));
+		break;
+	}
+	case InstructionOpcode::aaa:
+	case InstructionOpcode::aas:
+	{
+		const bool add = instr.opcode == InstructionOpcode::aaa;
+		uint8_t res = al;
+		uint8_t high = ah;
+		if (low_adjust) {
+			res = add ? res + 6 : res - 6;
+			high = add ? high + 1 : high - 1;
+		}
+		set_register(RegisterName::AL, res & 0xF);
+		set_register(RegisterName::AH, high);
+		update_flags(CF_BIT | AF_BIT, low_adjust ? CF_BIT | AF_BIT : 0);
+		break;
+	}
+	case InstructionOpcode::aam:
+		set_register(RegisterName::AH, al / 10);
+		set_register(RegisterName::AL, al % 10);
+		update_flags(SF_BIT | ZF_BIT | PF_BIT, szp_flags(al % 10, false));
+		break;
+	case InstructionOpcode::aad:
+	{
+		const uint8_t res = uint8_t(ah * 10 + al);
+		set_register(RegisterName::AX, res);
+		update_flags(SF_BIT | ZF_BIT | PF_BIT, szp_flags(res, false));
+		break;
+	}
+	default:
+		break;
+	}
 }
 
-void emulate(const std::vector<Instruction> &instructions) {
-	Register *regs = get_registers();
-	SegmentRegister *srs = get_srs();
+/**
+ * @return true if the conditional jump or loop at ip should be taken, loops decrement cx first.
+ */
+bool jump_taken(InstructionOpcode opcode) {
+	// Only the flags a condition reads are computed
+	switch (opcode) {
+	case InstructionOpcode::jmp: return true;
+	case InstructionOpcode::je: return flags_set(Flag::ZF);
+	case InstructionOpcode::jne: return !flags_set(Flag::ZF);
+	case InstructionOpcode::jl: return flags_set(Flag::SF) != flags_set(Flag::OF);
+	case InstructionOpcode::jnl: return flags_set(Flag::SF) == flags_set(Flag::OF);
+	case InstructionOpcode::jle: return flags_set(Flag::ZF) || flags_set(Flag::SF) != flags_set(Flag::OF);
+	case InstructionOpcode::jnle: return !flags_set(Flag::ZF) && flags_set(Flag::SF) == flags_set(Flag::OF);
+	case InstructionOpcode::jb: return flags_set(Flag::CF);
+	case InstructionOpcode::jnb: return !flags_set(Flag::CF);
+	case InstructionOpcode::jbe: return flags_set(Flag::CF | Flag::ZF);
+	case InstructionOpcode::jnbe: return !flags_set(Flag::CF | Flag::ZF);
+	case InstructionOpcode::jp: return flags_set(Flag::PF);
+	case InstructionOpcode::jnp: return !flags_set(Flag::PF);
+	case InstructionOpcode::jo: return flags_set(Flag::OF);
+	case InstructionOpcode::jno: return !flags_set(Flag::OF);
+	case InstructionOpcode::js: return flags_set(Flag::SF);
+	case InstructionOpcode::jns: return !flags_set(Flag::SF);
+	case InstructionOpcode::jcxz: return get_register_data(RegisterName::CX) == 0;
+	default:
+		break;
+	}
 
-	for (auto &instr : instructions) {
-		switch (instr.opcode) {
-		case InstructionOpcode::mov:
-			handle_mov(instr);
-			break;
-		case InstructionOpcode::add:
-			handle_add(instr);
-			break;
-		case InstructionOpcode::sub:
-			handle_sub(instr);
-			break;
-		case InstructionOpcode::cmp:
-			handle_cmp(instr);
+	const uint16_t cx = get_register_data(RegisterName::CX) - 1;
+	set_register(RegisterName::CX, cx);
+
+	switch (opcode) {
+	case InstructionOpcode::loop: return cx != 0;
+	case InstructionOpcode::loopz: return cx != 0 && flags_set(Flag::ZF);
+	case InstructionOpcode::loopnz: return cx != 0 && !flags_set(Flag::ZF);
+	default: return false;
+	}
+}
+
+void push(uint16_t data) {
+	const uint16_t sp = get_register_data(RegisterName::SP) - 2;
+	set_register(RegisterName::SP, sp);
+	write_memory(physical_address(SegmentRegisterName::SS, sp), data, true);
+}
+
+uint16_t pop() {
+	const uint16_t sp = get_register_data(RegisterName::SP);
+	set_register(RegisterName::SP, sp + 2);
+	return read_memory(physical_address(SegmentRegisterName::SS, sp), true);
+}
+
+/**
+ * Short jumps, loops and near jmp/call. ip already points at the next instruction.
+ */
+void handle_jump(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	const Operand &target = instr.operands[0];
+	if (target.type == OperandType::Label) {
+		if (jump_taken(instr.opcode)) {
+			set_ip(get_ip() + target.jmp_offset);
+		}
+		return;
+	}
+
+	if (instr.opcode == InstructionOpcode::call) {
+		push(get_ip());
+	}
+	if (target.type == OperandType::Immediate) {
+		set_ip(get_ip() + target.imm_value);
+	} else {
+		set_ip(read_operand(target, true));
+	}
+}
+
+void handle_ret(const Instruction &instr) {
+	PROFILE_FUNCTION;
+	set_ip(pop());
+	if (instr.operands[0].type == OperandType::Immediate) {
+		set_register(RegisterName::SP, get_register_data(RegisterName::SP) + instr.operands[0].imm_value);
+	}
+}
+
+enum class ExecResult {
+	Continue,
+	Halt,
+	DivideError,
+};
+
+/**
+ * Executes instr with ip already pointing at the next instruction.
+ */
+ExecResult execute(const Instruction &instr) {
+	switch (instr.opcode) {
+	case InstructionOpcode::mov:
+		handle_mov(instr);
+		break;
+	case InstructionOpcode::add:
+		handle_add(instr);
+		break;
+	case InstructionOpcode::sub:
+		handle_sub(instr);
+		break;
+	case InstructionOpcode::cmp:
+		handle_cmp(instr);
+		break;
+	case InstructionOpcode::adc:
+		handle_adc(instr);
+		break;
+	case InstructionOpcode::sbb:
+		handle_sbb(instr);
+		break;
+	case InstructionOpcode::and_:
+	case InstructionOpcode::or_:
+	case InstructionOpcode::xor_:
+	case InstructionOpcode::test:
+		handle_logic(instr);
+		break;
+	case InstructionOpcode::inc:
+	case InstructionOpcode::dec:
+		handle_inc_dec(instr);
+		break;
+	case InstructionOpcode::neg:
+		handle_neg(instr);
+		break;
+	case InstructionOpcode::not_:
+		handle_not(instr);
+		break;
+	case InstructionOpcode::sal:
+	case InstructionOpcode::shr:
+	case InstructionOpcode::sar:
+	case InstructionOpcode::rol:
+	case InstructionOpcode::ror:
+	case InstructionOpcode::rcl:
+	case InstructionOpcode::rcr:
+		handle_shift(instr);
+		break;
+	case InstructionOpcode::mul:
+	case InstructionOpcode::imul:
+		handle_mul(instr);
+		break;
+	case InstructionOpcode::div:
+	case InstructionOpcode::idiv:
+		if (!handle_div(instr)) {
+			fprintf(STREAM_ERR, "Divide error\n");
+			return ExecResult::DivideError;
+		}
+		break;
+	case InstructionOpcode::daa:
+	case InstructionOpcode::das:
+	case InstructionOpcode::aaa:
+	case InstructionOpcode::aas:
+	case InstructionOpcode::aam:
+	case InstructionOpcode::aad:
+		handle_bcd(instr);
+		break;
+	case InstructionOpcode::cbw:
+		set_register(RegisterName::AX, uint16_t(int8_t(get_register_data(RegisterName::AL))));
+		break;
+	case InstructionOpcode::cwd:
+		set_register(RegisterName::DX, (get_register_data(RegisterName::AX) & 0x8000) ? 0xFFFF : 0);
+		break;
+	case InstructionOpcode::clc:
+		update_flags(CF_BIT, 0);
+		break;
+	case InstructionOpcode::stc:
+		update_flags(CF_BIT, CF_BIT);
+		break;
+	case InstructionOpcode::cmc:
+		update_flags(CF_BIT, flags_set(Flag::CF) ? 0 : CF_BIT);
+		break;
+	case InstructionOpcode::cld:
+	case InstructionOpcode::std:
+		set_flag(Flag::DF, instr.opcode == InstructionOpcode::std);
+		break;
+	case InstructionOpcode::cli:
+	case InstructionOpcode::sti:
+		set_flag(Flag::IF, instr.opcode == InstructionOpcode::sti);
+		break;
+	case InstructionOpcode::call:
+	case InstructionOpcode::jmp:
+		if (instr.flags.far || instr.operands[0].type == OperandType::FarProc) {
+			fprintf(STREAM_OUT, "Ignoring instruction %s\n", get_instr_name(instr.opcode));
 			break;
-		default:
-			fprintf(STREAM_OUT, "Ignoring instruction %s\n", instr.name.c_str());
+		}
+		handle_jump(instr);
+		break;
+	case InstructionOpcode::ret:
+		handle_ret(instr);
+		break;
+	case InstructionOpcode::pushf:
+		push(static_cast<uint16_t>(current_flags()));
+		break;
+	case InstructionOpcode::popf:
+		set_flags(static_cast<Flag>(pop()));
+		break;
+	case InstructionOpcode::lahf:
+		set_register(RegisterName::AH, static_cast<uint16_t>(current_flags()));
+		break;
+	case InstructionOpcode::sahf:
+	{
+		// sahf only loads SF ZF AF PF CF
+		constexpr uint16_t mask = 0xD5;
+		const uint16_t f = static_cast<uint16_t>(current_flags());
+		set_flags(static_cast<Flag>((f & ~mask) | (get_register_data(RegisterName::AH) & mask)));
+		break;
+	}
+	case InstructionOpcode::hlt:
+		return ExecResult::Halt;
+	default:
+		if (instr.type == InstructionType::Jmp) {
+			handle_jump(instr);
 			break;
 		}
+		fprintf(STREAM_OUT, "Ignoring instruction %s\n", get_instr_name(instr.opcode));
+		break;
+	}
+
+	return ExecResult::Continue;
+}
+
+/**
+ * Register file as bytes, byte registers al..bh live at (r & 3) * 2 + (r >> 2) on little-endian hosts.
+ */
+static Register *const registers = get_registers();
+
+static_assert(sizeof(Register) == 2);
 
-		print_instr(instr);
-		fprintf(STREAM_OUT, " ; ");
-		print_flags();
-		fprintf(STREAM_OUT, "\n");
+/**
+ * Operand whose kind and width are known at compile time, memory operands resolve their address once.
+ */
+template <OperandType Kind, bool Wide>
+class OperandRef {
+public:
+	explicit OperandRef(const Operand &op) : op(op) {
+		if constexpr (Kind == OperandType::EffectiveAddress) {
+			addr = effective_address(op.eff_addr, op.displacement, op.seg_prefix);
+		} else if constexpr (Kind == OperandType::DirectAccess) {
+			addr = direct_address(op.direct_access, op.seg_prefix);
+		}
+	}
+
+	uint16_t load() const {
+		if constexpr (Kind == OperandType::Immediate) {
+			return Wide ? uint16_t(op.imm_value) : uint16_t(op.imm_value & 0xFF);
+		} else if constexpr (Kind == OperandType::Register || Kind == OperandType::Accumulator) {
+			if constexpr (Wide) {
+				return registers[reg_index()].data;
+			} else {
+				return reinterpret_cast<const uint8_t *>(registers)[reg_index()];
+			}
+		} else if constexpr (Kind == OperandType::SegmentRegister) {
+			return get_sr(op.seg_reg);
+		} else {
+			return read_memory(addr, Wide);
+		}
+	}
+
+	void store(uint16_t data) const {
+		if constexpr (Kind == OperandType::Register || Kind == OperandType::Accumulator) {
+			if constexpr (Wide) {
+				registers[reg_index()].data = data;
+			} else {
+				reinterpret_cast<uint8_t *>(registers)[reg_index()] = uint8_t(data);
+			}
+		} else if constexpr (Kind == OperandType::SegmentRegister) {
+			set_sr(op.seg_reg, data);
+		} else if constexpr (Kind == OperandType::EffectiveAddress || Kind == OperandType::DirectAccess) {
+			write_memory(addr, data, Wide);
+		}
 	}
+
+private:
+	/**
+	 * Index into registers for words, into its bytes otherwise
+	 */
+	int reg_index() const {
+		if constexpr (Kind == OperandType::Accumulator) {
+			return 0;
+		} else {
+			const int r = static_cast<int>(op.reg);
+			return Wide ? r - 8 : (r & 3) * 2 + (r >> 2);
+		}
+	}
+
+	const Operand &op;
+	uint32_t addr = 0;
+};
+
+/**
+ * mov and the two operand arithmetic and logic instructions for one combination of operand kinds and width.
+ */
+template <InstructionOpcode Op, OperandType Dest, OperandType Src, bool Wide>
+void specialized_handler(const Instruction &instr) {
+	static_assert(Dest != OperandType::Immediate);
+	// One anchor per opcode, shared by all of its forms
+	PROFILE_BLOCK(get_instr_name(Op));
+
+	const OperandRef<Dest, Wide> dest(instr.operands[0]);
+	const uint16_t src = OperandRef<Src, Wide>(instr.operands[1]).load();
+	if constexpr (Op == InstructionOpcode::mov) {
+		dest.store(src);
+	} else {
+		constexpr FlagOp flag_op = Op == InstructionOpcode::add ? FlagOp::Add
+			: Op == InstructionOpcode::adc ? FlagOp::Adc
+			: Op == InstructionOpcode::sub || Op == InstructionOpcode::cmp ? FlagOp::Sub
+			: Op == InstructionOpcode::sbb ? FlagOp::Sbb
+			: FlagOp::Logic;
+
+		const uint16_t dest_data = dest.load();
+		uint16_t res = 0;
+		if constexpr (Op == InstructionOpcode::add) {
+			res = dest_data + src;
+		} else if constexpr (Op == InstructionOpcode::adc) {
+			res = dest_data + src + flags_set(Flag::CF);
+		} else if constexpr (flag_op == FlagOp::Sub) {
+			res = dest_data - src;
+		} else if constexpr (Op == InstructionOpcode::sbb) {
+			res = dest_data - src - flags_set(Flag::CF);
+		} else if constexpr (Op == InstructionOpcode::or_) {
+			res = dest_data | src;
+		} else if constexpr (Op == InstructionOpcode::xor_) {
+			res = dest_data ^ src;
+		} else {
+			res = dest_data & src;
+		}
+
+		if constexpr (Op != InstructionOpcode::cmp && Op != InstructionOpcode::test) {
+			dest.store(res);
+		}
+		if constexpr (flag_op == FlagOp::Logic) {
+			set_lazy_flags(FlagOp::Logic, res, 0, res, Wide);
+		} else {
+			set_lazy_flags(flag_op, dest_data, src, res, Wide);
+		}
+	}
+}
+
+constexpr bool writes_memory(InstructionOpcode opcode, OperandType dest) {
+	return (dest == OperandType::EffectiveAddress || dest == OperandType::DirectAccess)
+		&& opcode != InstructionOpcode::cmp && opcode != InstructionOpcode::test;
+}
+
+/**
+ * Operand forms the decoder produces for mov and the two operand arithmetic and logic instructions,
+ * X(opcode, destination kind, source kind, width) is expanded once for each of them.
+ */
+#define BOTH_WIDTHS(X, op, dest, src) X(op, dest, src, 8) X(op, dest, src, 16)
+
+#define ALU_FORMS(X, op) \
+	BOTH_WIDTHS(X, op, Accumulator, Immediate) \
+	BOTH_WIDTHS(X, op, Register, Immediate) \
+	BOTH_WIDTHS(X, op, Register, Register) \
+	BOTH_WIDTHS(X, op, Register, EffectiveAddress) \
+	BOTH_WIDTHS(X, op, Register, DirectAccess) \
+	BOTH_WIDTHS(X, op, EffectiveAddress, Immediate) \
+	BOTH_WIDTHS(X, op, EffectiveAddress, Register) \
+	BOTH_WIDTHS(X, op, DirectAccess, Immediate) \
+	BOTH_WIDTHS(X, op, DirectAccess, Register)
+
+#define SPECIALIZED_FORMS(X) \
+	BOTH_WIDTHS(X, mov, Accumulator, DirectAccess) \
+	BOTH_WIDTHS(X, mov, Register, Immediate) \
+	BOTH_WIDTHS(X, mov, Register, Register) \
+	BOTH_WIDTHS(X, mov, Register, EffectiveAddress) \
+	BOTH_WIDTHS(X, mov, Register, DirectAccess) \
+	BOTH_WIDTHS(X, mov, EffectiveAddress, Immediate) \
+	BOTH_WIDTHS(X, mov, EffectiveAddress, Register) \
+	BOTH_WIDTHS(X, mov, DirectAccess, Immediate) \
+	BOTH_WIDTHS(X, mov, DirectAccess, Accumulator) \
+	BOTH_WIDTHS(X, mov, DirectAccess, Register) \
+	X(mov, Register, SegmentRegister, 16) \
+	X(mov, SegmentRegister, Register, 16) \
+	X(mov, SegmentRegister, EffectiveAddress, 16) \
+	X(mov, SegmentRegister, DirectAccess, 16) \
+	X(mov, EffectiveAddress, SegmentRegister, 16) \
+	X(mov, DirectAccess, SegmentRegister, 16) \
+	ALU_FORMS(X, add) \
+	ALU_FORMS(X, adc) \
+	ALU_FORMS(X, sub) \
+	ALU_FORMS(X, sbb) \
+	ALU_FORMS(X, cmp) \
+	ALU_FORMS(X, and_) \
+	ALU_FORMS(X, or_) \
+	ALU_FORMS(X, xor_) \
+	ALU_FORMS(X, test)
+
+#define FORM_NAME(op, dest, src, width) op##dest##_##src##_##width
+#define RUN_FORM(op, dest, src, width) \
+	specialized_handler<InstructionOpcode::op, OperandType::dest, OperandType::src, width == 16>(entry->instr)
+#define FORM_WRITES_MEMORY(op, dest) writes_memory(InstructionOpcode::op, OperandType::dest)
+
+namespace handlers {
+
+enum : HandlerIndex {
+	end_of_block = END_OF_BLOCK,
+	generic = GENERIC_HANDLER,
+#define HANDLER_INDEX(op, dest, src, width) FORM_NAME(op, dest, src, width),
+	SPECIALIZED_FORMS(HANDLER_INDEX)
+#undef HANDLER_INDEX
+	count,
+};
+
+} // namespace handlers
+
+struct SpecializedForm {
+	InstructionOpcode opcode;
+	OperandType dest;
+	OperandType src;
+	bool wide;
+};
+
+/**
+ * In the order of their handler indices, starting right after GENERIC_HANDLER
+ */
+constexpr SpecializedForm specialized_forms[] = {
+#define FORM_ENTRY(op, dest, src, width) { InstructionOpcode::op, OperandType::dest, OperandType::src, width == 16 },
+	SPECIALIZED_FORMS(FORM_ENTRY)
+#undef FORM_ENTRY
+};
+
+static_assert(std::size(specialized_forms) == handlers::count - GENERIC_HANDLER - 1);
+
+HandlerIndex select_handler(const Instruction &instr) {
+	for (const Operand &operand : instr.operands) {
+		if (operand.type == OperandType::Register && (operand.reg >= RegisterName::AX) != instr.flags.wide) {
+			return GENERIC_HANDLER;
+		}
+	}
+
+	for (std::size_t i = 0; i < std::size(specialized_forms); ++i) {
+		const SpecializedForm &form = specialized_forms[i];
+		if (form.opcode == instr.opcode && form.dest == instr.operands[0].type
+			&& form.src == instr.operands[1].type && form.wide == instr.flags.wide) {
+			return HandlerIndex(GENERIC_HANDLER + 1 + i);
+		}
+	}
+
+	return GENERIC_HANDLER;
+}
+
+template <typename Trace>
+StopReason emulate(const uint8_t *program, std::size_t size, Trace &trace, uint64_t max_instructions) {
+	PROFILE_COUNTERS("emulate", 0);
+	reset_machine();
+	const uint32_t code_base = physical_address(SegmentRegisterName::CS, 0);
+	size = std::min<std::size_t>(size, MEMORY_SIZE - code_base);
+	memcpy(get_memory() + code_base, program, size);
+	set_ip(0);
+
+	BlockCache cache;
+	Block *block = nullptr;
+	uint64_t remaining = max_instructions;
+
+#if THREADED_DISPATCH
+	// One label per handler, each ending in its own indirect jump to the next instruction
+	static void *const handler_labels[] = {
+		&&handler_end_of_block,
+		&&handler_generic,
+#define HANDLER_LABEL(op, dest, src, width) &&handler_##op##dest##_##src##_##width,
+		SPECIALIZED_FORMS(HANDLER_LABEL)
+#undef HANDLER_LABEL
+	};
+	static_assert(std::size(handler_labels) == handlers::count);
+
+	/*
+	 * ip is kept in a local while a block runs and only stored for the generic handler,
+	 * which may read or change it, and whenever execution leaves the block.
+	 */
+#define NEXT_INSTRUCTION(may_write_memory) \
+	if (--remaining == 0) { \
+		set_ip(ip); \
+		return StopReason::Finished; \
+	} \
+	/* The block itself may have been overwritten */ \
+	if ((may_write_memory) && code_written()) { \
+		set_ip(ip); \
+		cache.invalidate_written(); \
+		block = nullptr; \
+		continue; \
+	} \
+	++entry; \
+	goto *handler_labels[entry->handler]
+
+#define HANDLER_BODY(op, dest, src, width) \
+	handler_##op##dest##_##src##_##width: { \
+		const uint16_t instr_ip = ip; \
+		ip += entry->length; \
+		RUN_FORM(op, dest, src, width); \
+		trace.instruction(entry->instr, instr_ip, entry->length); \
+		NEXT_INSTRUCTION(FORM_WRITES_MEMORY(op, dest)); \
+	}
+#endif
+
+	while (remaining > 0 && get_ip() < size) {
+		uint16_t ip = get_ip();
+		const uint32_t addr = physical_address(SegmentRegisterName::CS, ip);
+		block = block ? cache.next(*block, addr, uint32_t(size - ip)) : cache.get(addr, uint32_t(size - ip));
+		if (!block) {
+			return StopReason::Unsupported;
+		}
+
+		const InstructionCache::Entry *entry = block->instrs.data();
+#if THREADED_DISPATCH
+		goto *handler_labels[entry->handler];
+
+	handler_generic: {
+		const uint16_t instr_ip = ip;
+		set_ip(ip + entry->length);
+		const ExecResult result = execute(entry->instr);
+		ip = get_ip();
+		trace.instruction(entry->instr, instr_ip, entry->length);
+		if (result != ExecResult::Continue) {
+			return result == ExecResult::Halt ? StopReason::Finished : StopReason::DivideError;
+		}
+		NEXT_INSTRUCTION(true);
+	}
+
+		SPECIALIZED_FORMS(HANDLER_BODY)
+
+	handler_end_of_block:
+		set_ip(ip);
+#else
+		for (; entry->handler != END_OF_BLOCK; ++entry) {
+			const uint16_t instr_ip = ip;
+			ip += entry->length;
+			ExecResult result = ExecResult::Continue;
+			bool may_write_memory = true;
+			switch (entry->handler) {
+#define HANDLER_CASE(op, dest, src, width) \
+			case handlers::FORM_NAME(op, dest, src, width): \
+				RUN_FORM(op, dest, src, width); \
+				may_write_memory = FORM_WRITES_MEMORY(op, dest); \
+				break;
+			SPECIALIZED_FORMS(HANDLER_CASE)
+#undef HANDLER_CASE
+			default:
+				set_ip(ip);
+				result = execute(entry->instr);
+				ip = get_ip();
+				break;
+			}
+			trace.instruction(entry->instr, instr_ip, entry->length);
+
+			if (result != ExecResult::Continue) {
+				return result == ExecResult::Halt ? StopReason::Finished : StopReason::DivideError;
+			}
+			if (--remaining == 0) {
+				set_ip(ip);
+				return StopReason::Finished;
+			}
+			// The block itself may have been overwritten
+			if (may_write_memory && code_written()) {
+				cache.invalidate_written();
+				block = nullptr;
+				break;
+			}
+		}
+		set_ip(ip);
+#endif
+	}
+
+	return StopReason::Finished;
 }
 
+#undef NEXT_INSTRUCTION
+#undef HANDLER_BODY
+#undef RUN_FORM
+#undef FORM_WRITES_MEMORY
+#undef FORM_NAME
+#undef SPECIALIZED_FORMS
+#undef ALU_FORMS
+#undef BOTH_WIDTHS
+
+template StopReason emulate(const uint8_t *program, std::size_t size, NoTrace &trace, uint64_t max_instructions);
+template StopReason emulate(const uint8_t *program, std::size_t size, CountTrace &trace, uint64_t max_instructions);
+template StopReason emulate(const uint8_t *program, std::size_t size, RingTrace<> &trace, uint64_t max_instructions);
+template StopReason emulate(const uint8_t *program, std::size_t size, TextTrace &trace, uint64_t max_instructions);
+
 } // namespace emu8086
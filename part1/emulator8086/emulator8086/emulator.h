@@ -1,11 +1,42 @@
 #pragma once
 
 #include "instructions.h"
+#include "trace.h"
 
-#include <vector>
+#include <cstdint>
 
 namespace emu8086 {
 
-void emulate(const std::vector<Instruction> &instructions);
+/**
+ * Handler emulate() runs an instruction with. Every operand form of mov and the two operand
+ * arithmetic and logic instructions has its own, all other instructions share the generic one.
+ */
+using HandlerIndex = uint16_t;
+
+constexpr HandlerIndex END_OF_BLOCK = 0; // past the last instruction of a block, continue with the next block
+constexpr HandlerIndex GENERIC_HANDLER = 1; // switches on the opcode, can stop execution
+
+/**
+ * @breif Handler specialized for the opcode, operand kinds and width of instr.
+ * Picked once when the instruction is decoded.
+ */
+HandlerIndex select_handler(const Instruction &instr);
+
+/**
+ * Why emulate() returned
+ */
+enum class StopReason {
+	Finished, // ip left the program, hlt or max_instructions
+	Unsupported, // at an instruction that can't be decoded
+	DivideError, // division by zero or a quotient that doesn't fit
+};
+
+/**
+ * @breif Resets the machine, loads program at cs:0 of guest memory and runs it from ip 0, passing every instruction to trace.
+ * Stops when ip leaves the program, on hlt, after max_instructions or at the first fault.
+ * Instantiated for the trace policies in trace.h.
+ */
+template <typename Trace>
+StopReason emulate(const uint8_t *program, std::size_t size, Trace &trace, uint64_t max_instructions = UINT64_MAX);
 
 } // namespace emu8086
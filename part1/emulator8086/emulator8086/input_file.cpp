@@ -0,0 +1,149 @@
+#include "input_file.h"
+#include "decoder.h"
+
+#include <cstdio>
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace emu8086 {
+
+InputFile::~InputFile() {
+	close();
+}
+
+bool InputFile::open(const char *filename, LoadMode mode) {
+	close();
+
+	std::error_code ec;
+	file_size = std::filesystem::file_size(filename, ec);
+	if (ec) {
+		return false;
+	}
+
+	if (mode != LoadMode::Read && file_size > 0 && map(filename, mode)) {
+		return true;
+	}
+
+	return read(filename);
+}
+
+void InputFile::close() {
+	if (mapped()) {
+#ifdef _WIN32
+		UnmapViewOfFile(view);
+#else
+		munmap(const_cast<uint8_t *>(view), mapping_size);
+#endif
+	}
+
+	buffer.reset();
+	view = nullptr;
+	mapping_size = 0;
+}
+
+bool InputFile::read(const char *filename) {
+	FILE *f = fopen(filename, "rb");
+	if (!f) {
+		return false;
+	}
+
+	buffer.reset(new uint8_t[file_size + DECODE_PADDING]());
+	auto bytes_read = fread(buffer.get(), sizeof(uint8_t), file_size, f);
+	fclose(f);
+
+	view = buffer.get();
+	return bytes_read == file_size;
+}
+
+#ifdef _WIN32
+
+bool InputFile::map(const char *filename, LoadMode mode) {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+
+	// Bytes past the end of file are only readable up to the end of its
+	// last page, there is no way to place zero pages after the view.
+	const std::size_t tail = file_size % info.dwPageSize;
+	if (tail == 0 || info.dwPageSize - tail < DECODE_PADDING) {
+		return false;
+	}
+
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) {
+		return false;
+	}
+
+	void *ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!ptr) {
+		return false;
+	}
+
+	if (mode == LoadMode::MapPopulate) {
+		WIN32_MEMORY_RANGE_ENTRY range = { ptr, file_size };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+	view = static_cast<const uint8_t *>(ptr);
+	mapping_size = file_size;
+	return true;
+}
+
+#else
+
+bool InputFile::map(const char *filename, LoadMode mode) {
+	const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	const std::size_t size = (file_size + DECODE_PADDING + page_size - 1) / page_size * page_size;
+
+	int fd = ::open(filename, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	// Reserve zeroed pages for the file and the padding, then put the file
+	// over the start of it. The rest of the file's last page reads as zero.
+	void *reserved = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (reserved == MAP_FAILED) {
+		::close(fd);
+		return false;
+	}
+
+	int flags = MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_POPULATE
+	if (mode == LoadMode::MapPopulate) {
+		flags |= MAP_POPULATE;
+	}
+#endif
+
+	void *ptr = mmap(reserved, file_size, PROT_READ, flags, fd, 0);
+	::close(fd);
+	if (ptr == MAP_FAILED) {
+		munmap(reserved, size);
+		return false;
+	}
+
+	madvise(ptr, file_size, MADV_SEQUENTIAL);
+
+	view = static_cast<const uint8_t *>(ptr);
+	mapping_size = size;
+	return true;
+}
+
+#endif
+
+} // namespace emu8086
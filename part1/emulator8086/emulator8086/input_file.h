@@ -0,0 +1,45 @@
+#pragma once
+
+#include "emu8086.h"
+
+#include <memory>
+
+namespace emu8086 {
+
+enum class LoadMode {
+	Read, // heap buffer filled with fread
+	Map, // mmap with MADV_SEQUENTIAL, pages are faulted in while decoding
+	MapPopulate, // mmap with MAP_POPULATE, pages are read in before returning
+};
+
+/**
+ * Read-only view of a whole input file that decode() can read directly.
+ * The view is always followed by at least DECODE_PADDING zero bytes.
+ * If the file can't be mapped it falls back to LoadMode::Read.
+ */
+class InputFile {
+public:
+	InputFile() = default;
+	~InputFile();
+
+	InputFile(const InputFile &) = delete;
+	InputFile &operator=(const InputFile &) = delete;
+
+	bool open(const char *filename, LoadMode mode = LoadMode::Map);
+	void close();
+
+	const std::uint8_t *data() const { return view; }
+	std::size_t size() const { return file_size; }
+	bool mapped() const { return mapping_size != 0; }
+
+private:
+	bool map(const char *filename, LoadMode mode);
+	bool read(const char *filename);
+
+	const std::uint8_t *view = nullptr;
+	std::size_t file_size = 0;
+	std::size_t mapping_size = 0;
+	std::unique_ptr<std::uint8_t[]> buffer;
+};
+
+} // namespace emu8086
@@ -0,0 +1,42 @@
+#include "instr_cache.h"
+
+#include "decoder.h"
+
+namespace emu8086 {
+
+static_assert(MEMORY_PADDING >= DECODE_PADDING);
+
+void InstructionCache::invalidate(uint32_t page) {
+	pages[page].reset();
+
+	// Instructions near the end of the previous page can reach into this one.
+	// Decoding doesn't wrap around the address space, so page 0 has none.
+	Entry *prev = page > 0 ? pages[page - 1].get() : nullptr;
+	if (!prev) {
+		return;
+	}
+	for (uint32_t offset = PAGE_SIZE - UINT8_MAX; offset < PAGE_SIZE; ++offset) {
+		if (offset + prev[offset].length > PAGE_SIZE) {
+			prev[offset].length = 0;
+		}
+	}
+}
+
+const InstructionCache::Entry *InstructionCache::decode(uint32_t addr) {
+	std::unique_ptr<Entry[]> &page = pages[addr >> PAGE_BITS];
+	if (!page) {
+		page.reset(new Entry[PAGE_SIZE]());
+	}
+
+	Entry &entry = page[addr & (PAGE_SIZE - 1)];
+	const std::size_t length = decode_instruction(get_memory() + addr, MEMORY_SIZE - addr, entry.instr);
+	if (length == 0 || length > UINT8_MAX) {
+		return nullptr;
+	}
+
+	entry.length = static_cast<uint8_t>(length);
+	entry.handler = select_handler(entry.instr);
+	return &entry;
+}
+
+} // namespace emu8086
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "emu8086.h"
+#include "emulator.h"
+#include "instructions.h"
+#include "memory.h"
+
+#include <memory>
+
+namespace emu8086 {
+
+/**
+ * Instructions decoded from guest memory keyed by their physical address,
+ * so code which runs many times is only decoded the first time.
+ * Pages of entries are allocated when code in them is first fetched.
+ */
+class InstructionCache {
+public:
+	struct Entry {
+		Instruction instr;
+		uint8_t length = 0; // including prefixes, 0 while not decoded
+		HandlerIndex handler = END_OF_BLOCK;
+	};
+
+	static constexpr uint32_t PAGE_BITS = CODE_PAGE_BITS;
+	static constexpr uint32_t PAGE_SIZE = 1 << PAGE_BITS;
+
+	/**
+	 * @return instruction starting at addr, decoded from guest memory on the first fetch.
+	 * nullptr if there is no supported instruction at addr.
+	 */
+	const Entry *fetch(uint32_t addr) {
+		const Entry *page = pages[addr >> PAGE_BITS].get();
+		if (page && page[addr & (PAGE_SIZE - 1)].length) {
+			return &page[addr & (PAGE_SIZE - 1)];
+		}
+
+		return decode(addr);
+	}
+
+	/**
+	 * Forgets every instruction decoded from the page, which is a CODE_PAGE_BITS page of guest memory,
+	 * and those on the page before it which reach into it.
+	 */
+	void invalidate(uint32_t page);
+
+private:
+	const Entry *decode(uint32_t addr);
+
+	std::unique_ptr<Entry[]> pages[MEMORY_SIZE / PAGE_SIZE];
+};
+
+} // namespace emu8086
@@ -4,12 +4,14 @@
 
 namespace emu8086 {
 
-#include "scripts/instr_table.inl"
-
 Instruction get_instruction(uint8_t opcode) {
 	return instructions[opcode];
 }
 
+const char *get_instr_name(InstructionOpcode opcode) {
+	return instr_opcode_names[static_cast<int>(opcode)].data();
+}
+
 Instruction get_special_instruction(const Instruction& ins, uint8_t second_byte) {
 	return special_instructions[ins.__special_instr_idx][(second_byte & SB_REG_MASK)>>3];
 }
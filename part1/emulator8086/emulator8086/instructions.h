@@ -4,7 +4,8 @@
 #include "memory.h"
 #include "scripts/instr_opcodes.h"
 
-#include <string>
+#include <array>
+#include <type_traits>
 
 namespace emu8086 {
 
@@ -24,7 +25,14 @@ constexpr uint8_t MOD_MASK = 0xC0;
 constexpr uint8_t SB_REG_MASK = 0x38;
 constexpr uint8_t REGMEM_MASK = 0x07;
 
-enum class OperandType {
+enum MemoryMode {
+	NO_DISPLACEMENT = 0b00,
+	SHORT = 0b01,
+	WIDE = 0b10, 
+	REGISTER = 0b11,
+};
+
+enum class OperandType : uint8_t {
 	None,
 
 	Label,
@@ -38,45 +46,110 @@ enum class OperandType {
 };
 
 struct Operand {
-	OperandType type;
+	OperandType type = OperandType::None;
+	uint8_t seg_prefix = 0xff;
 	union {
-		struct {
-			int16_t far_proc_ip;
-		};
+		int16_t imm_value = 0;
+		int16_t far_proc_ip;
 		int8_t jmp_offset;
-		int16_t imm_value;
 		RegisterName reg;
 		EffectiveAddress eff_addr;
 		SegmentRegisterName seg_reg;
 	};
 	union {
-		struct {
-			int16_t far_proc_cs;
-		};
-		int16_t displacement;
+		int16_t displacement = 0;
+		int16_t far_proc_cs;
 		uint16_t direct_access;
 	};
-	uint8_t seg_prefix = 0xff;
 };
 
+/**
+ * Plain 16 byte record so the decoded stream can be copied around
+ * with memcpy. Name of the instruction is looked up by its opcode.
+ */
 struct Instruction {
-	std::string name;
 	InstructionType type;
 	InstructionOpcode opcode;
-	int __special_instr_idx; // For internal use only
+	int8_t __special_instr_idx = -1; // For internal use only
 
 	// Populated by decoder
-	Operand operands[2];
 	struct {
-		bool wide = false;
-		bool dest = false;
-		bool locked = false;
-		bool repeated = false;
-		bool string_op = false;
-		bool far = false;
+		bool wide : 1 = false;
+		bool dest : 1 = false;
+		bool locked : 1 = false;
+		bool repeated : 1 = false;
+		bool string_op : 1 = false;
+		bool far : 1 = false;
 	} flags;
+	Operand operands[2];
+};
+
+static_assert(sizeof(Instruction) <= 16);
+static_assert(std::is_trivially_copyable_v<Instruction>);
+
+#include "scripts/instr_table.inl"
+
+/**
+ * Everything the decoder needs to know about a ModRM byte.
+ * Displacement is sign extended via (disp << disp_shift) >> disp_shift
+ * and zeroed by disp_mask when there is none.
+ */
+struct ModRMInfo {
+	OperandType type; // Register, EffectiveAddress or DirectAccess
+	uint8_t disp_size; // in bytes
+	uint8_t disp_shift;
+	uint16_t disp_mask;
+	uint8_t regmem[2]; // indexed by the wide bit. RegisterName or EffectiveAddress
+	uint8_t reg;
 };
 
+constexpr std::array<ModRMInfo, 256> make_modrm_table() {
+	std::array<ModRMInfo, 256> table{};
+	for (int i = 0; i < 256; ++i) {
+		const uint8_t mode = (i & MOD_MASK) >> 6;
+		const uint8_t regmem = (i & REGMEM_MASK);
+
+		ModRMInfo &info = table[i];
+		info.reg = (i & SB_REG_MASK) >> 3;
+		info.regmem[0] = regmem;
+		info.regmem[1] = regmem;
+		if (mode == MemoryMode::REGISTER) {
+			info.type = OperandType::Register;
+			info.regmem[1] = regmem + 8;
+		} else if (mode == MemoryMode::NO_DISPLACEMENT && regmem == 0x6) {
+			info.type = OperandType::DirectAccess;
+			info.disp_size = 2;
+		} else {
+			info.type = OperandType::EffectiveAddress;
+			info.disp_size = mode == MemoryMode::WIDE ? 2 : mode;
+		}
+		info.disp_shift = info.disp_size == 1 ? 8 : 0;
+		info.disp_mask = info.disp_size ? 0xFFFF : 0;
+	}
+
+	return table;
+}
+
+inline constexpr std::array<ModRMInfo, 256> modrm_table = make_modrm_table();
+
+enum InstrLengthFlags : uint8_t {
+	LENGTH_MODRM = 0x1, // size doesn't include the ModRM displacement
+	LENGTH_PREFIX = 0x2, // belongs to the instruction that follows
+	LENGTH_GROUP_IMM = 0x4, // has an immediate when reg field of ModRM is 0
+};
+
+/**
+ * Byte length of an instruction by its first byte.
+ */
+struct InstrLength {
+	uint8_t size;
+	uint8_t flags;
+};
+
+#include "scripts/instr_length_table.inl"
+
+const char *get_instr_name(InstructionOpcode opcode);
+
 Instruction get_instruction(uint8_t opcode);
 Instruction get_special_instruction(const Instruction& ins, uint8_t snd_byte);
 
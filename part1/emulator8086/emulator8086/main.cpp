@@ -1,60 +1,280 @@
 #include <cstdio>
 #include <filesystem>
 
+#include "decode_cache.h"
 #include "decoder.h"
 #include "instructions.h"
 #include "emulator.h"
+#include "input_file.h"
+#include "profiler.h"
+#include "thread_pool.h"
+#include "trace.h"
 
+#include <atomic>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace fs = std::filesystem;
+
+/**
+ * @breif Decode source, or with use_cache load <path>.decoded.cache instead if it matches the input
+ * and write it otherwise.
+ */
+static bool decode_input(emu8086::Decoder &decoder, const emu8086::InputFile &source, const fs::path &path, bool use_cache, unsigned threads) {
+	if (!use_cache) {
+		return decoder.decode(source.data(), source.size(), threads);
+	}
+
+	const std::string cache_path = path.string() + ".decoded.cache";
+	const uint64_t hash = emu8086::hash_input(source.data(), source.size());
+	if (decoder.load_cache(cache_path.c_str(), hash, source.size())) {
+		return true;
+	}
+
+	if (!decoder.decode(source.data(), source.size(), threads)) {
+		return false;
+	}
+
+	if (!decoder.save_cache(cache_path.c_str(), hash, source.size())) {
+		fprintf(STREAM_ERR, "Failed to write cache file %s!\n", cache_path.c_str());
+	}
+
+	return true;
+}
+
+/**
+ * @breif Execute source with the trace policy for mode, ring and count traces are printed at the end.
+ */
+static emu8086::StopReason run(const emu8086::InputFile &source, emu8086::TraceMode mode) {
+	switch (mode) {
+	case emu8086::TraceMode::None: {
+		emu8086::NoTrace trace;
+		return emu8086::emulate(source.data(), source.size(), trace);
+	}
+	case emu8086::TraceMode::Count: {
+		emu8086::CountTrace trace;
+		const emu8086::StopReason res = emu8086::emulate(source.data(), source.size(), trace);
+		fprintf(STREAM_OUT, "%llu instructions executed\n", static_cast<unsigned long long>(trace.count));
+		return res;
+	}
+	case emu8086::TraceMode::Ring: {
+		emu8086::RingTrace<> trace;
+		const emu8086::StopReason res = emu8086::emulate(source.data(), source.size(), trace);
+		trace.print();
+		return res;
+	}
+	default: {
+		emu8086::TextTrace trace;
+		return emu8086::emulate(source.data(), source.size(), trace);
+	}
+	}
+}
+
+/**
+ * @breif Disassemble every input into its own .asm file on a thread pool. Returns the number of failed inputs.
+ */
+static int run_batch(const std::vector<fs::path> &inputs, const fs::path &out_dir, unsigned threads, emu8086::LoadMode load_mode, bool use_cache) {
+	std::atomic<int> failed = 0;
+
+	emu8086::ThreadPool pool(threads);
+	for (const auto &input : inputs) {
+		pool.submit([&input, &out_dir, &failed, load_mode, use_cache]() {
+			emu8086::InputFile source;
+			if (!source.open(input.string().c_str(), load_mode)) {
+				fprintf(STREAM_ERR, "Failed to read file %s!\n", input.string().c_str());
+				++failed;
+				return;
+			}
+
+			emu8086::Decoder decoder;
+			if (!decode_input(decoder, source, input, use_cache, 1)) {
+				fprintf(STREAM_ERR, "%s: instruction not supported! Idx: %zu\n", input.string().c_str(), decoder.instructions().size());
+				++failed;
+				return;
+			}
+
+			fs::path output = input;
+			output += ".decoded.asm";
+			if (!out_dir.empty()) {
+				output = out_dir / output.filename();
+			}
+
+			FILE *out = fopen(output.string().c_str(), "wb");
+			if (!out) {
+				fprintf(STREAM_ERR, "Failed to open output file %s!\n", output.string().c_str());
+				++failed;
+				return;
+			}
+
+			decoder.print_asm(out);
+			fclose(out);
+		});
+	}
+	pool.wait();
+
+	return failed;
+}
 
 int main(int argc, char **argv) {
+#if PROFILER
+	emu8086::begin_profile();
+	struct ProfilePrinter {
+		~ProfilePrinter() { emu8086::end_and_print_profile(); }
+	} profile_printer;
+#endif
+
 	if (argc < 2) {
-		fprintf(STREAM_OUT, "Usage: %s <filename> [<param>,]\n", argv[0]);
+		fprintf(STREAM_OUT, "Usage: %s <filename>... [<param>,]\n", argv[0]);
 		fprintf(STREAM_OUT, "\tSupported parameters:\n");
 		fprintf(STREAM_OUT, "\t\t-exec Execute the decoded instructions\n");
 		fprintf(STREAM_OUT, "\t\t-print Print asm of decoded instructions\n");
+		fprintf(STREAM_OUT, "\t\t-threads <n> Decode and format on n threads, 0 for all cores\n");
+		fprintf(STREAM_OUT, "\t\t-out <dir> Directory for batch mode outputs\n");
+		fprintf(STREAM_OUT, "\t\t-cache Reuse <file>.decoded.cache if it matches the input, write it if not\n");
+		fprintf(STREAM_OUT, "\t\t-load <mmap|populate|read> How input files are loaded, mmap by default\n");
+		fprintf(STREAM_OUT, "\t\t-trace <text|ring|count|none> What -exec traces, every instruction as text by default\n");
+		fprintf(STREAM_OUT, "\tPassing several files or a directory disassembles each into <file>.decoded.asm\n");
+		fprintf(STREAM_OUT, "\tPassing - as filename disassembles stdin while it is being read\n");
 		return 1;
 	}
 
-	const char *filename = argv[1];
-
+	std::vector<fs::path> inputs;
+	fs::path out_dir;
+	bool batch = false;
 	bool exec = false;
 	bool print = false;
-	for (int i = 2; i < argc; ++i) {
+	unsigned threads = 1;
+	bool threads_set = false;
+	emu8086::LoadMode load_mode = emu8086::LoadMode::Map;
+	bool use_cache = false;
+	bool stream = false;
+	emu8086::TraceMode trace_mode = emu8086::TraceMode::Text;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-") == 0) {
+			stream = true;
+			continue;
+		}
+		if (argv[i][0] != '-') {
+			fs::path path = argv[i];
+			if (fs::is_directory(path)) {
+				for (const auto &entry : fs::directory_iterator(path)) {
+					if (entry.is_regular_file() && entry.path().extension() != ".asm" && entry.path().extension() != ".cache") {
+						inputs.push_back(entry.path());
+					}
+				}
+				batch = true;
+			} else {
+				inputs.push_back(path);
+			}
+			continue;
+		}
+
 		if (strncmp(argv[i], "-exec", 5) == 0) {
 			exec = true;
 		}
 		if (strncmp(argv[i], "-print", 5) == 0) {
 			print = true;
 		}
+		if (strncmp(argv[i], "-threads", 8) == 0 && i + 1 < argc) {
+			threads = static_cast<unsigned>(atoi(argv[++i]));
+			threads_set = true;
+		}
+		if (strncmp(argv[i], "-out", 4) == 0 && i + 1 < argc) {
+			out_dir = argv[++i];
+		}
+		if (strncmp(argv[i], "-cache", 6) == 0) {
+			use_cache = true;
+		}
+		if (strncmp(argv[i], "-load", 5) == 0 && i + 1 < argc) {
+			++i;
+			if (strcmp(argv[i], "read") == 0) {
+				load_mode = emu8086::LoadMode::Read;
+			} else if (strcmp(argv[i], "populate") == 0) {
+				load_mode = emu8086::LoadMode::MapPopulate;
+			} else {
+				load_mode = emu8086::LoadMode::Map;
+			}
+		}
+		if (strncmp(argv[i], "-trace", 6) == 0 && i + 1 < argc) {
+			++i;
+			if (strcmp(argv[i], "none") == 0) {
+				trace_mode = emu8086::TraceMode::None;
+			} else if (strcmp(argv[i], "count") == 0) {
+				trace_mode = emu8086::TraceMode::Count;
+			} else if (strcmp(argv[i], "ring") == 0) {
+				trace_mode = emu8086::TraceMode::Ring;
+			} else {
+				trace_mode = emu8086::TraceMode::Text;
+			}
+		}
 	}
 
-	auto filesize = std::filesystem::file_size(filename);
-
-	FILE *f = fopen(filename, "rb");
-	if (f) {
-		std::unique_ptr<uint8_t[]> source(new uint8_t[filesize]);
-		auto bytes_read = fread(source.get(), sizeof(uint8_t), filesize, f);
-		
-		if (bytes_read != filesize) {
-			fprintf(STREAM_ERR, "Failed to read file %s!\n", filename);
+	if (stream) {
+#ifdef _WIN32
+		_setmode(_fileno(stdin), _O_BINARY);
+#endif
+		emu8086::StreamDecoder decoder;
+		if (!decoder.decode(stdin)) {
+			fprintf(STREAM_OUT, "instruction not supported! Type: 0 Idx: %zu\n", decoder.count());
 			return 1;
 		}
 
-		emu8086::decode(source.get(), filesize);
+		return 0;
+	}
+
+	if (batch || inputs.size() > 1 || !out_dir.empty()) {
+		if (!out_dir.empty()) {
+			fs::create_directories(out_dir);
+		}
+
+		return run_batch(inputs, out_dir, threads_set ? threads : 0, load_mode, use_cache) == 0 ? 0 : 1;
+	}
+
+	if (inputs.empty()) {
+		return 1;
+	}
+
+	const auto &filename = inputs.front();
+
+	emu8086::InputFile source;
+	if (!source.open(filename.string().c_str(), load_mode)) {
+		fprintf(STREAM_ERR, "Failed to read file %s!\n", filename.string().c_str());
+		return 1;
+	}
+
+	// Execution decodes from guest memory as it goes
+	if (print || !exec) {
+		emu8086::Decoder decoder;
+		if (!decode_input(decoder, source, filename, use_cache, threads)) {
+			fprintf(STREAM_OUT, "instruction not supported! Type: 0 Idx: %zu\n", decoder.instructions().size());
+			return 1;
+		}
 
 		if (print) {
-			emu8086::print_asm();
+			decoder.print_asm(STREAM_OUT, threads);
 		}
+	}
 
-		if (exec) {
-			auto instructions = emu8086::get_decoded_instructions();
-			emu8086::emulate(instructions);
-			emu8086::print_state();
-			fprintf(STREAM_OUT, "\n");
+	if (exec) {
+		const emu8086::StopReason reason = run(source, trace_mode);
+		if (reason == emu8086::StopReason::Unsupported) {
+			fprintf(STREAM_OUT, "instruction not supported! Ip: %04x\n", emu8086::get_ip());
+			return 1;
+		}
+		emu8086::print_state();
+		fprintf(STREAM_OUT, "\n");
+		if (reason == emu8086::StopReason::DivideError) {
+			return 1;
 		}
 	}
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -1,13 +1,35 @@
 #include "memory.h"
 
+#include "alu.h"
+
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <utility>
 
 namespace emu8086 {
 
 Register registers[8];
 SegmentRegister seg_regs[4];
+uint32_t seg_bases[4];
+uint16_t ip;
 Flag flags;
 
+struct LazyFlags {
+	FlagOp op = FlagOp::None;
+	bool wide = false;
+	uint16_t dest = 0;
+	uint16_t src = 0;
+	uint16_t result = 0;
+};
+
+LazyFlags lazy_flags;
+
+alignas(64) uint8_t memory[MEMORY_SIZE + MEMORY_PADDING];
+bool code_pages[CODE_PAGE_COUNT];
+std::vector<uint32_t> written_code_pages;
+
 namespace detail {
 
 Flag from(uint16_t value) {
@@ -18,6 +40,62 @@ uint16_t to(Flag f) {
 	return static_cast<uint16_t>(f);
 }
 
+/**
+ * Computes the flags in mask from the recorded operation, mask holds only arithmetic flags.
+ */
+uint16_t compute_flags(uint16_t mask) {
+	const LazyFlags &lazy = lazy_flags;
+	return alu_flags(lazy.op, lazy.dest, lazy.src, lazy.result, lazy.wide) & mask;
+}
+
+void materialize_flags() {
+	const uint16_t mask = flag_op_mask(lazy_flags.op);
+	if (mask == 0) {
+		return;
+	}
+
+	flags = from((to(flags) & ~mask) | compute_flags(mask));
+	lazy_flags.op = FlagOp::None;
+}
+
+}
+
+/**
+ * Registers which make up an EffectiveAddress, index is masked out when there is none.
+ */
+struct EffectiveAddressTerms {
+	uint8_t base;
+	uint8_t index;
+	uint16_t index_mask;
+	SegmentRegisterName segment;
+};
+
+constexpr uint8_t BX = 3;
+constexpr uint8_t BP = 5;
+constexpr uint8_t SI = 6;
+constexpr uint8_t DI = 7;
+
+constexpr EffectiveAddressTerms eff_addr_terms[8] = {
+	{ BX, SI, 0xFFFF, SegmentRegisterName::DS },
+	{ BX, DI, 0xFFFF, SegmentRegisterName::DS },
+	{ BP, SI, 0xFFFF, SegmentRegisterName::SS },
+	{ BP, DI, 0xFFFF, SegmentRegisterName::SS },
+	{ SI, 0, 0, SegmentRegisterName::DS },
+	{ DI, 0, 0, SegmentRegisterName::DS },
+	{ BP, 0, 0, SegmentRegisterName::SS },
+	{ BX, 0, 0, SegmentRegisterName::DS },
+};
+
+void reset_machine() {
+	std::fill(std::begin(registers), std::end(registers), Register {});
+	std::fill(std::begin(seg_regs), std::end(seg_regs), SegmentRegister(0));
+	std::fill(std::begin(seg_bases), std::end(seg_bases), 0u);
+	ip = 0;
+	flags = Flag::EMPTY;
+	lazy_flags = {};
+	std::memset(memory, 0, sizeof(memory));
+	std::fill(std::begin(code_pages), std::end(code_pages), false);
+	written_code_pages.clear();
 }
 
 Register *get_registers() {
@@ -47,6 +125,7 @@ void set_register(RegisterName reg, uint16_t data) {
 }
 
 void print_flags() {
+	detail::materialize_flags();
 	fprintf(STREAM_OUT, "flags:");
 	auto f = detail::to(flags);
 	for (int i = 15; i >= 0; --i) {
@@ -60,12 +139,13 @@ void print_state() {
 	static constexpr int idxs[8] = { 0, 3, 1, 2, 4, 5, 6, 7 };
 	fprintf(STREAM_OUT, "\n==========================================\n");
 	for (int i = 0; i < 8; ++i) {
-		fprintf(STREAM_OUT, "%s -> %04x\n", reg_to_str[idxs[i] + 8], registers[idxs[i]].data);
+		fprintf(STREAM_OUT, "%s -> %04x\n", reg_to_str[idxs[i] + 8].data(), registers[idxs[i]].data);
 	}
 
 	for (int i = 0; i < 4; ++i) {
-		fprintf(STREAM_OUT, "%s -> %04x\n", sr_to_str[i], seg_regs[i]);
+		fprintf(STREAM_OUT, "%s -> %04x\n", sr_to_str[i].data(), seg_regs[i]);
 	}
+	fprintf(STREAM_OUT, "ip -> %04x\n", ip);
 
 	print_flags();
 }
@@ -80,18 +160,114 @@ SegmentRegister get_sr(SegmentRegisterName sr) {
 
 void set_sr(SegmentRegisterName sr, uint16_t data) {
 	seg_regs[static_cast<int>(sr)] = data;
+	seg_bases[static_cast<int>(sr)] = uint32_t(data) << 4;
+}
+
+uint16_t get_ip() {
+	return ip;
+}
+
+void set_ip(uint16_t data) {
+	ip = data;
+}
+
+uint8_t *get_memory() {
+	return memory;
+}
+
+uint32_t physical_address(SegmentRegisterName sr, uint16_t offset) {
+	return (seg_bases[static_cast<int>(sr)] + offset) & ADDRESS_MASK;
+}
+
+uint32_t effective_address(EffectiveAddress ea, int16_t displacement, uint8_t seg_prefix) {
+	const EffectiveAddressTerms &terms = eff_addr_terms[static_cast<int>(ea)];
+	const uint16_t offset = uint16_t(registers[terms.base].data + (registers[terms.index].data & terms.index_mask) + displacement);
+	const int sr = seg_prefix < 4 ? seg_prefix : static_cast<int>(terms.segment);
+
+	return (seg_bases[sr] + offset) & ADDRESS_MASK;
+}
+
+uint32_t direct_address(uint16_t offset, uint8_t seg_prefix) {
+	const int sr = seg_prefix < 4 ? seg_prefix : static_cast<int>(SegmentRegisterName::DS);
+
+	return (seg_bases[sr] + offset) & ADDRESS_MASK;
+}
+
+uint16_t read_memory(uint32_t addr, bool wide) {
+	if (!wide) {
+		return memory[addr];
+	}
+
+	return uint16_t(memory[addr] | (memory[(addr + 1) & ADDRESS_MASK] << 8));
+}
+
+static void check_code_write(uint32_t addr) {
+	const uint32_t page = addr >> CODE_PAGE_BITS;
+	if (code_pages[page]) {
+		code_pages[page] = false;
+		written_code_pages.push_back(page);
+	}
+}
+
+void write_memory(uint32_t addr, uint16_t data, bool wide) {
+	memory[addr] = uint8_t(data);
+	check_code_write(addr);
+	if (wide) {
+		const uint32_t high = (addr + 1) & ADDRESS_MASK;
+		memory[high] = uint8_t(data >> 8);
+		check_code_write(high);
+	}
+}
+
+void mark_code_page(uint32_t page) {
+	code_pages[page] = true;
+}
+
+bool code_written() {
+	return !written_code_pages.empty();
+}
+
+std::vector<uint32_t> take_written_code_pages() {
+	return std::exchange(written_code_pages, {});
 }
 
 Flag operator|(Flag f1, Flag f2) {
 	return detail::from(detail::to(f1) | detail::to(f2));
 }
 
+void set_lazy_flags(FlagOp op, uint16_t dest, uint16_t src, uint16_t result, bool wide) {
+	// Flags the operation keeps must be known before the record is replaced
+	if (flag_op_mask(op) != ARITHMETIC_FLAGS) {
+		detail::materialize_flags();
+	}
+
+	const uint16_t width_mask = wide ? 0xFFFF : 0xFF;
+	lazy_flags = { op, wide, uint16_t(dest & width_mask), uint16_t(src & width_mask), uint16_t(result & width_mask) };
+}
+
+void update_flags(uint16_t mask, uint16_t values) {
+	detail::materialize_flags();
+	flags = detail::from((detail::to(flags) & ~mask) | (values & mask));
+}
+
 bool flags_set(Flag flag) {
-	return (detail::to(flag) & detail::to(flags)) != 0;
+	const uint16_t f = detail::to(flag);
+	const uint16_t lazy_mask = flag_op_mask(lazy_flags.op) & f;
+	if (lazy_mask) {
+		return (detail::compute_flags(lazy_mask) | (f & ~lazy_mask & detail::to(flags))) != 0;
+	}
+
+	return (f & detail::to(flags)) != 0;
+}
+
+Flag current_flags() {
+	detail::materialize_flags();
+	return flags;
 }
 
 void set_flags(Flag f) {
 	flags = f;
+	lazy_flags.op = FlagOp::None;
 }
 
 std::vector<Flag> get_flags(Flag flag) {
@@ -107,6 +283,7 @@ std::vector<Flag> get_flags(Flag flag) {
 }
 
 void set_flag(Flag flag, bool set) {
+	detail::materialize_flags();
 	if (set) {
 		flags = flags | flag;
 	} else {
@@ -3,23 +3,24 @@
 #include "emu8086.h"
 
 #include <cstdint>
+#include <string_view>
 #include <vector>
 
 namespace emu8086 {
 
-enum class RegisterName {
+enum class RegisterName : uint8_t {
 	AL = 0, CL, DL, BL, AH, CH, DH, BH,
 	AX, CX, DX, BX, SP, BP, SI, DI,
 };
 
-enum class SegmentRegisterName {
+enum class SegmentRegisterName : uint8_t {
 	ES = 0,
 	CS,
 	SS,
 	DS,
 };
 
-enum class EffectiveAddress {
+enum class EffectiveAddress : uint8_t {
 	BX_SI = 0,
 	BX_DI,
 	BP_SI,
@@ -65,12 +66,12 @@ static const char *flag_name[16] = {
 	"UnknownFlag15",
 };
 
-static const char *reg_to_str[16] = {
+inline constexpr std::string_view reg_to_str[16] = {
 	"al", "cl", "dl", "bl", "ah", "ch", "dh", "bh",
 	"ax", "cx", "dx", "bx", "sp", "bp", "si", "di",
 };
 
-static const char *eff_addr_to_str[8] = {
+inline constexpr std::string_view eff_addr_to_str[8] = {
 	"bx + si",
 	"bx + di",
 	"bp + si",
@@ -81,7 +82,7 @@ static const char *eff_addr_to_str[8] = {
 	"bx",
 };
 
-static const char *sr_to_str[4] = {
+inline constexpr std::string_view sr_to_str[4] = {
 	"es", "cs", "ss", "ds"
 };
 
@@ -99,6 +100,19 @@ struct Register {
 
 using SegmentRegister = uint16_t;
 
+constexpr uint32_t MEMORY_SIZE = 1 << 20;
+constexpr uint32_t ADDRESS_MASK = MEMORY_SIZE - 1;
+/**
+ * Zeroed bytes after the end of guest memory so instructions at the very top
+ * can be decoded in place, must be at least DECODE_PADDING.
+ */
+constexpr uint32_t MEMORY_PADDING = 16;
+
+/**
+ * @breif Zeroes registers, segment registers, ip, flags and guest memory, and forgets translated code pages.
+ */
+void reset_machine();
+
 Register *get_registers();
 /**
  * short registers's data is returned in the LSB
@@ -106,11 +120,76 @@ Register *get_registers();
 uint16_t get_register_data(RegisterName reg);
 void set_register(RegisterName reg, uint16_t data);
 
+/**
+ * Segment registers must be changed through set_sr so the cached segment bases stay valid
+ */
 SegmentRegister *get_srs();
 SegmentRegister get_sr(SegmentRegisterName sr);
 void set_sr(SegmentRegisterName sr, uint16_t data);
 
+uint16_t get_ip();
+void set_ip(uint16_t data);
+
+/**
+ * @breif Flat 1 MB guest memory, aligned to a cache line and followed by MEMORY_PADDING bytes
+ */
+uint8_t *get_memory();
+
+/**
+ * @breif 20 bit physical address of the memory operand, seg_prefix is 0xff when there is no segment override.
+ * Effective addresses default to SS when based on bp and to DS otherwise, direct accesses always to DS.
+ */
+uint32_t physical_address(SegmentRegisterName sr, uint16_t offset);
+uint32_t effective_address(EffectiveAddress ea, int16_t displacement, uint8_t seg_prefix);
+uint32_t direct_address(uint16_t offset, uint8_t seg_prefix);
+
+/**
+ * Words are little-endian and wrap around at the end of the address space
+ */
+uint16_t read_memory(uint32_t addr, bool wide);
+void write_memory(uint32_t addr, uint16_t data, bool wide);
+
+/**
+ * Guest memory is tracked in pages of 1 << CODE_PAGE_BITS bytes to catch writes to translated code.
+ * Writing to a page marked with mark_code_page() unmarks it and reports it through take_written_code_pages().
+ */
+constexpr uint32_t CODE_PAGE_BITS = 12;
+constexpr uint32_t CODE_PAGE_COUNT = MEMORY_SIZE >> CODE_PAGE_BITS;
+
+void mark_code_page(uint32_t page);
+bool code_written();
+std::vector<uint32_t> take_written_code_pages();
+
+/**
+ * Operation the arithmetic flags (CF PF AF ZF SF OF) are computed from
+ */
+enum class FlagOp : uint8_t {
+	None, // flags are up to date
+	Add,
+	Adc,
+	Sub, // also cmp and neg
+	Sbb,
+	Logic, // and, or, xor and test
+	Inc, // like Add and Sub but CF is kept
+	Dec,
+};
+
+/**
+ * @breif Records the last flag producing operation instead of computing its flags,
+ * each arithmetic flag is only computed when something reads it.
+ */
+void set_lazy_flags(FlagOp op, uint16_t dest, uint16_t src, uint16_t result, bool wide);
+
+/**
+ * @breif Sets the arithmetic flags in mask to values right away, for operations which aren't worth recording.
+ */
+void update_flags(uint16_t mask, uint16_t values);
+
 bool flags_set(Flag flag);
+/**
+ * All flags with the arithmetic ones computed, for pushf and lahf
+ */
+Flag current_flags();
 void set_flags(Flag flags);
 std::vector<Flag> get_flags(Flag flag);
 void set_flag(Flag flag, bool set);
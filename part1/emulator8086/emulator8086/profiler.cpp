@@ -0,0 +1,287 @@
+#include "profiler.h"
+
+#include <chrono>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_RDTSC 1
+#endif
+
+#if PROFILER && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace emu8086 {
+
+std::uint64_t read_os_timer_us() {
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::uint64_t read_cpu_timer() {
+#ifdef HAS_RDTSC
+	return __rdtsc();
+#else
+	using namespace std::chrono;
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+std::uint64_t estimate_cpu_timer_freq(std::uint64_t wait_ms) {
+	const std::uint64_t os_start = read_os_timer_us();
+	const std::uint64_t cpu_start = read_cpu_timer();
+
+	std::uint64_t os_end = os_start;
+	while (os_end - os_start < wait_ms * 1000) {
+		os_end = read_os_timer_us();
+	}
+
+	const std::uint64_t cpu_end = read_cpu_timer();
+	return (cpu_end - cpu_start) * 1000000 / (os_end - os_start);
+}
+
+static std::uint64_t profile_start = 0;
+
+#if PROFILER
+
+namespace profiler {
+
+struct Registry {
+	std::mutex mutex;
+	const char *labels[MAX_ANCHORS] = { "<root>" };
+	std::uint32_t count = 1; // 0 is the root every top level block nests in
+	std::vector<ThreadAnchors *> live;
+	Anchor retired[MAX_ANCHORS];
+};
+
+static Registry &registry() {
+	static Registry instance;
+	return instance;
+}
+
+static void add_anchor(Anchor &sum, const Anchor &anchor) {
+	sum.tsc_exclusive += anchor.tsc_exclusive;
+	sum.tsc_inclusive += anchor.tsc_inclusive;
+	sum.hit_count += anchor.hit_count;
+	sum.processed_bytes += anchor.processed_bytes;
+	for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+		sum.counters[i] += anchor.counters[i];
+	}
+	sum.counter_hits += anchor.counter_hits;
+}
+
+static const char *perf_event_names[PERF_EVENT_COUNT] = {
+	"instructions",
+	"branch misses",
+	"L1D misses",
+	"LLC misses",
+	"page faults",
+};
+
+#ifdef __linux__
+
+PerfCounters::PerfCounters() {
+	struct EventConfig {
+		std::uint32_t type;
+		std::uint64_t config;
+	};
+
+	static constexpr EventConfig configs[PERF_EVENT_COUNT] = {
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+		{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+	};
+
+	for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+		perf_event_attr attr = {};
+		attr.size = sizeof(attr);
+		attr.type = configs[i].type;
+		attr.config = configs[i].config;
+		attr.disabled = leader < 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// Events the CPU or kernel doesn't have fail to open and are left out.
+		fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+		slots[i] = -1;
+		if (fds[i] < 0) {
+			continue;
+		}
+
+		if (leader < 0) {
+			leader = fds[i];
+		}
+		slots[i] = slot_count++;
+	}
+
+	if (leader >= 0) {
+		ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+}
+
+PerfCounters::~PerfCounters() {
+	for (int fd : fds) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+}
+
+bool PerfCounters::read(std::uint64_t (&values)[PERF_EVENT_COUNT]) const {
+	if (leader < 0) {
+		return false;
+	}
+
+	// nr, time_enabled, time_running, then one value per event
+	std::uint64_t data[3 + PERF_EVENT_COUNT];
+	if (::read(leader, data, sizeof(data)) < static_cast<ssize_t>((3 + slot_count) * sizeof(std::uint64_t))) {
+		return false;
+	}
+
+	const std::uint64_t enabled = data[1];
+	const std::uint64_t running = data[2];
+	for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+		std::uint64_t value = slots[i] >= 0 ? data[3 + slots[i]] : 0;
+		if (running && running < enabled) {
+			value = static_cast<std::uint64_t>(double(value) * enabled / running);
+		}
+		values[i] = value;
+	}
+
+	return true;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+	for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+		fds[i] = -1;
+		slots[i] = -1;
+	}
+}
+
+PerfCounters::~PerfCounters() {
+}
+
+bool PerfCounters::read(std::uint64_t (&)[PERF_EVENT_COUNT]) const {
+	return false;
+}
+
+#endif
+
+ThreadAnchors::ThreadAnchors() {
+	Registry &reg = registry();
+	std::lock_guard lock(reg.mutex);
+	reg.live.push_back(this);
+}
+
+ThreadAnchors::~ThreadAnchors() {
+	Registry &reg = registry();
+	std::lock_guard lock(reg.mutex);
+	std::erase(reg.live, this);
+	for (std::uint32_t i = 0; i < MAX_ANCHORS; ++i) {
+		add_anchor(reg.retired[i], anchors[i]);
+	}
+}
+
+std::uint32_t register_anchor(const char *label) {
+	Registry &reg = registry();
+	std::lock_guard lock(reg.mutex);
+	for (std::uint32_t i = 1; i < reg.count; ++i) {
+		if (std::string_view(reg.labels[i]) == label) {
+			return i;
+		}
+	}
+
+	if (reg.count == MAX_ANCHORS) {
+		return 0;
+	}
+
+	reg.labels[reg.count] = label;
+	return reg.count++;
+}
+
+} // namespace profiler
+
+#endif
+
+void begin_profile() {
+	profile_start = read_cpu_timer();
+}
+
+void end_and_print_profile(FILE *out) {
+	const std::uint64_t total = read_cpu_timer() - profile_start;
+	const std::uint64_t freq = estimate_cpu_timer_freq();
+
+	// Anchor times are summed over threads, so with several threads
+	// percentages are of wall time and can add up to more than 100.
+	fprintf(out, "\nTotal time: %.4fms (CPU freq %llu)\n", 1000.0 * total / freq, static_cast<unsigned long long>(freq));
+
+#if PROFILER
+	profiler::Registry &reg = profiler::registry();
+	std::lock_guard lock(reg.mutex);
+
+	// Other threads have finished by now, their live tables are only read.
+	profiler::Anchor sums[profiler::MAX_ANCHORS];
+	for (std::uint32_t i = 1; i < reg.count; ++i) {
+		sums[i] = reg.retired[i];
+		for (const profiler::ThreadAnchors *thread : reg.live) {
+			profiler::add_anchor(sums[i], thread->anchors[i]);
+		}
+	}
+
+	for (std::uint32_t i = 1; i < reg.count; ++i) {
+		const profiler::Anchor &anchor = sums[i];
+		if (anchor.hit_count == 0) {
+			continue;
+		}
+
+		fprintf(out, "  %s[%llu]: %llu (%.2f%%", reg.labels[i], static_cast<unsigned long long>(anchor.hit_count),
+			static_cast<unsigned long long>(anchor.tsc_exclusive), 100.0 * anchor.tsc_exclusive / total);
+		if (anchor.tsc_inclusive != anchor.tsc_exclusive) {
+			fprintf(out, ", %.2f%% w/children", 100.0 * anchor.tsc_inclusive / total);
+		}
+		fprintf(out, ")");
+
+		if (anchor.processed_bytes) {
+			const double seconds = double(anchor.tsc_inclusive) / freq;
+			const double megabytes = anchor.processed_bytes / (1024.0 * 1024.0);
+			fprintf(out, "  %.3fmb at %.2fmb/s", megabytes, megabytes / seconds);
+		}
+		fprintf(out, "\n");
+
+		if (anchor.counter_hits) {
+			const profiler::PerfCounters &counters = profiler::thread_counters;
+			fprintf(out, "   ");
+			for (int e = 0; e < profiler::PERF_EVENT_COUNT; ++e) {
+				if (counters.available(static_cast<profiler::PerfEvent>(e))) {
+					fprintf(out, " %s: %llu", profiler::perf_event_names[e], static_cast<unsigned long long>(anchor.counters[e]));
+				}
+			}
+			if (counters.available(profiler::PERF_INSTRUCTIONS) && anchor.tsc_inclusive) {
+				fprintf(out, " (%.2f instructions/tsc)", double(anchor.counters[profiler::PERF_INSTRUCTIONS]) / anchor.tsc_inclusive);
+			}
+			fprintf(out, "\n");
+		}
+	}
+
+	if (!profiler::thread_counters.available(profiler::PERF_INSTRUCTIONS)) {
+		fprintf(out, "  hardware counters not available (perf_event_open)\n");
+	}
+#endif
+}
+
+} // namespace emu8086
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "emu8086.h"
+
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * Scoped RDTSC timing anchors. Build with PROFILER=1 to enable, otherwise
+ * PROFILE_* macros expand to nothing and nothing is timed.
+ *
+ *   void foo() {
+ *       PROFILE_FUNCTION;
+ *       { PROFILE_BLOCK("inner"); ... }
+ *   }
+ *
+ * Exclusive time of an anchor excludes its nested anchors, inclusive time
+ * counts a recursive anchor only once. Each thread times into its own
+ * table and the tables are summed when printing.
+ *
+ * PROFILE_COUNTERS(name, bytes) also reads hardware counters of the calling
+ * thread (Linux perf_event_open). Counter values are inclusive. Counters the
+ * kernel or CPU doesn't offer are left out.
+ */
+#ifndef PROFILER
+#define PROFILER 0
+#endif
+
+namespace emu8086 {
+
+std::uint64_t read_os_timer_us();
+std::uint64_t read_cpu_timer();
+
+/**
+ * Measures CPU timer ticks per second against the OS clock.
+ */
+std::uint64_t estimate_cpu_timer_freq(std::uint64_t wait_ms = 100);
+
+void begin_profile();
+void end_and_print_profile(FILE *out = STREAM_ERR);
+
+#if PROFILER
+
+namespace profiler {
+
+constexpr std::uint32_t MAX_ANCHORS = 128;
+
+enum PerfEvent {
+	PERF_INSTRUCTIONS,
+	PERF_BRANCH_MISSES,
+	PERF_L1D_MISSES,
+	PERF_LLC_MISSES,
+	PERF_PAGE_FAULTS,
+	PERF_EVENT_COUNT,
+};
+
+struct Anchor {
+	std::uint64_t tsc_exclusive = 0;
+	std::uint64_t tsc_inclusive = 0;
+	std::uint64_t hit_count = 0;
+	std::uint64_t processed_bytes = 0;
+	std::uint64_t counters[PERF_EVENT_COUNT] = {};
+	std::uint64_t counter_hits = 0;
+};
+
+/**
+ * One perf_event_open group per thread, opened on first use.
+ */
+class PerfCounters {
+public:
+	PerfCounters();
+	~PerfCounters();
+
+	PerfCounters(const PerfCounters &) = delete;
+	PerfCounters &operator=(const PerfCounters &) = delete;
+
+	/**
+	 * Reads current counter values, scaled if the kernel had to multiplex.
+	 * @return false if no counter is available.
+	 */
+	bool read(std::uint64_t (&values)[PERF_EVENT_COUNT]) const;
+
+	bool available(PerfEvent event) const { return fds[event] >= 0; }
+
+private:
+	int leader = -1;
+	int fds[PERF_EVENT_COUNT];
+	int slots[PERF_EVENT_COUNT]; // position of each event in a group read
+	int slot_count = 0;
+};
+
+inline thread_local PerfCounters thread_counters;
+
+struct ThreadAnchors {
+	ThreadAnchors();
+	~ThreadAnchors();
+
+	Anchor anchors[MAX_ANCHORS];
+	std::uint32_t parent = 0;
+};
+
+inline thread_local ThreadAnchors thread_anchors;
+
+/**
+ * Returns the anchor index for label, anchors with the same label share one.
+ */
+std::uint32_t register_anchor(const char *label);
+
+class Block {
+public:
+	Block(std::uint32_t anchor, std::uint64_t bytes = 0) : anchor(anchor) {
+		ThreadAnchors &anchors = thread_anchors;
+		parent = anchors.parent;
+		anchors.parent = anchor;
+		old_inclusive = anchors.anchors[anchor].tsc_inclusive;
+		anchors.anchors[anchor].processed_bytes += bytes;
+		start = read_cpu_timer();
+	}
+
+	~Block() {
+		const std::uint64_t elapsed = read_cpu_timer() - start;
+		ThreadAnchors &anchors = thread_anchors;
+		anchors.parent = parent;
+
+		anchors.anchors[parent].tsc_exclusive -= elapsed;
+		Anchor &self = anchors.anchors[anchor];
+		self.tsc_exclusive += elapsed;
+		self.tsc_inclusive = old_inclusive + elapsed;
+		++self.hit_count;
+	}
+
+	Block(const Block &) = delete;
+	Block &operator=(const Block &) = delete;
+
+private:
+	std::uint64_t start;
+	std::uint64_t old_inclusive;
+	std::uint32_t anchor;
+	std::uint32_t parent;
+};
+
+class CounterBlock {
+public:
+	explicit CounterBlock(std::uint32_t anchor) : anchor(anchor) {
+		valid = thread_counters.read(start);
+	}
+
+	~CounterBlock() {
+		std::uint64_t end[PERF_EVENT_COUNT];
+		if (!valid || !thread_counters.read(end)) {
+			return;
+		}
+
+		Anchor &self = thread_anchors.anchors[anchor];
+		for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+			self.counters[i] += end[i] - start[i];
+		}
+		++self.counter_hits;
+	}
+
+	CounterBlock(const CounterBlock &) = delete;
+	CounterBlock &operator=(const CounterBlock &) = delete;
+
+private:
+	std::uint64_t start[PERF_EVENT_COUNT];
+	std::uint32_t anchor;
+	bool valid;
+};
+
+} // namespace profiler
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_BANDWIDTH(name, bytes) \
+	static const std::uint32_t PROFILE_CONCAT(profile_anchor_, __LINE__) = ::emu8086::profiler::register_anchor(name); \
+	::emu8086::profiler::Block PROFILE_CONCAT(profile_block_, __LINE__)(PROFILE_CONCAT(profile_anchor_, __LINE__), bytes)
+#define PROFILE_BLOCK(name) PROFILE_BANDWIDTH(name, 0)
+#define PROFILE_FUNCTION PROFILE_BLOCK(__func__)
+#define PROFILE_COUNTERS(name, bytes) \
+	PROFILE_BANDWIDTH(name, bytes); \
+	::emu8086::profiler::CounterBlock PROFILE_CONCAT(profile_counters_, __LINE__)(PROFILE_CONCAT(profile_anchor_, __LINE__))
+
+#else
+
+#define PROFILE_COUNTERS(...)
+#define PROFILE_BANDWIDTH(...)
+#define PROFILE_BLOCK(...)
+#define PROFILE_FUNCTION
+
+#endif
+
+} // namespace emu8086
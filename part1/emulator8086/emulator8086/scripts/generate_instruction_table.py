@@ -57,7 +57,7 @@ for line in instrs:
 
 with open("instr_table.inl", 'w') as f:
     f.write("// DO NOT MODIFY!!! Automatically generated by generate_instruction_table.py.\n\n")
-    f.write('Instruction special_instructions[7][8] = {\n')
+    f.write('inline constexpr Instruction special_instructions[7][8] = {\n')
     f.write('   {\n')
 
     idx = 0
@@ -71,7 +71,7 @@ with open("instr_table.inl", 'w') as f:
             opcode = opcode + "_"
         instr_names.add(opcode)
         instr_types.add(tokens[1])
-        f.write('       {{ \"{}\", InstructionType::{}, InstructionOpcode::{} }},\n'.format(tokens[0], tokens[1], opcode))
+        f.write('       {{ InstructionType::{}, InstructionOpcode::{} }},\n'.format(tokens[1], opcode))
         idx = idx + 1
         if idx == 8:
             idx = 0
@@ -81,7 +81,7 @@ with open("instr_table.inl", 'w') as f:
                 f.write('   {\n')
     f.write('};\n\n')
 
-    f.write('Instruction instructions[256] = {\n')
+    f.write('inline constexpr Instruction instructions[256] = {\n')
     for i, instr in enumerate(instr_table):
         if instr == None:
             #print("Unknown instruction: {:02X}".format(i))
@@ -95,23 +95,136 @@ with open("instr_table.inl", 'w') as f:
         if opcode in ["and", "or", "xor", "int", "not"]:
             opcode = opcode + "_"
         instr_names.add(opcode)
-        f.write('   {{ \"{}\", InstructionType::{}, InstructionOpcode::{}, {} }},\n'.format(instr[0], instr[1], opcode, instr[2]))
+        f.write('   {{ InstructionType::{}, InstructionOpcode::{}, {} }},\n'.format(instr[1], opcode, instr[2]))
+    f.write('};\n')
+
+def opcode_enum_name(name):
+    if name == "-":
+        return "Unknown"
+    if name in ["and", "or", "xor", "int", "not"]:
+        return name + "_"
+    return name
+
+# Every opcode gets its own decode function instantiated with the opcode
+# as a template argument so width, direction and sign extension bits are
+# known at compile time. Group opcodes get one row of 8 functions each,
+# indexed by the reg field of the second byte.
+with open("instr_decode_table.inl", 'w') as f:
+    f.write("// DO NOT MODIFY!!! Automatically generated by generate_instruction_table.py.\n\n")
+
+    special_rows = []
+    for i, instr in enumerate(instr_table):
+        if instr != None and instr[1] == "Special":
+            special_rows.append([i, int(instr[2])])
+
+    f.write('constexpr DecodeFn special_decode_table[{}][8] = {{\n'.format(len(special_rows)))
+    for opcode, special_idx in special_rows:
+        f.write('   {\n')
+        for line in special[special_idx * 8:special_idx * 8 + 8]:
+            tokens = line.split(' ')
+            if tokens[1] == "Unknown":
+                f.write('       &decode_unknown,\n')
+                continue
+            name = opcode_enum_name(tokens[0])
+            f.write('       &decode_instr<0x{:02X}, InstructionType::{}, InstructionOpcode::{}>,\n'.format(opcode, tokens[1], name))
+        f.write('   },\n')
+    f.write('};\n\n')
+
+    f.write('constexpr DecodeFn decode_table[256] = {\n')
+    for i, instr in enumerate(instr_table):
+        if instr == None or instr[1] == "Unknown":
+            f.write('   &decode_unknown,\n')
+            continue
+        if instr[1] == "Special":
+            row = [r[0] for r in special_rows].index(i)
+            f.write('   &decode_special<0x{:02X}, {}>,\n'.format(i, row))
+            continue
+        name = opcode_enum_name(instr[0])
+        f.write('   &decode_instr<0x{:02X}, InstructionType::{}, InstructionOpcode::{}>,\n'.format(i, instr[1], name))
+    f.write('};\n')
+
+modrm_types = ["RegMem_Reg", "RegMem", "RegMem_1", "RegMem_CL", "RegMem_Far", "Mem_Reg", "Esc",
+               "SR_RegMem", "Imm_RegMem", "Imm_RegMem_SE", "Special"]
+
+# Size of the immediate/address bytes following the opcode (and ModRM byte).
+def immediate_size(opcode, instr_type):
+    wide = opcode & 0x01
+    sign_extended = opcode & 0x02
+    if instr_type == "Imm_RegMem" or instr_type == "Imm_Acc":
+        return 2 if wide else 1
+    if instr_type == "Imm_RegMem_SE":
+        return 2 if wide and not sign_extended else 1
+    if instr_type == "Imm_Reg":
+        return 2 if opcode & 0x08 else 1
+    if instr_type in ["Mem_Acc", "Acc_Mem", "Imm16", "NearProc"]:
+        return 2
+    if instr_type in ["Jmp", "Imm8", "FixedPort", "SkipSecond"]:
+        return 1
+    if instr_type == "FarProc":
+        return 4
+    return 0
+
+# Instruction lengths without the ModRM displacement, which is added at
+# runtime from modrm_table. Only "test" in group 4 has an immediate which
+# depends on the reg field so it's flagged instead of getting its own table.
+with open("instr_length_table.inl", 'w') as f:
+    f.write("// DO NOT MODIFY!!! Automatically generated by generate_instruction_table.py.\n\n")
+    f.write('inline constexpr InstrLength instr_lengths[256] = {\n')
+    for i, instr in enumerate(instr_table):
+        if instr == None or instr[1] == "Unknown":
+            f.write('   { 1, 0 }, // Unknown\n')
+            continue
+
+        instr_type = instr[1]
+        flags = []
+        if instr_type == "SegmentPrefix" or instr[0] in ["lock", "rep"]:
+            flags.append("LENGTH_PREFIX")
+        if instr_type in modrm_types:
+            flags.append("LENGTH_MODRM")
+
+        size = 1 + immediate_size(i, instr_type)
+        if instr_type in modrm_types:
+            size = size + 1
+        if instr_type == "Special":
+            group = special[int(instr[2]) * 8:int(instr[2]) * 8 + 8]
+            imm_sizes = {}
+            for reg, line in enumerate(group):
+                tokens = line.split(' ')
+                if tokens[1] != "Unknown":
+                    imm_sizes[reg] = immediate_size(i, tokens[1])
+            if len(set(imm_sizes.values())) > 1:
+                assert [reg for reg in imm_sizes if imm_sizes[reg] != 0] == [0], "Only reg 0 may have a group specific immediate"
+                flags.append("LENGTH_GROUP_IMM")
+            else:
+                size = size + imm_sizes[0]
+
+        flags = "uint8_t({})".format(" | ".join(flags)) if len(flags) > 1 else (flags[0] if flags else "0")
+        f.write('   {{ {}, {} }}, // {}\n'.format(size, flags, instr[0]))
     f.write('};\n')
 
 with open("instr_opcodes.h", 'w') as f:
     f.write("// DO NOT MODIFY!!! Automatically generated by generate_instruction_table.py.\n\n")
     f.write('#pragma once\n\n')
+    f.write('#include <cstdint>\n#include <string_view>\n\n')
     f.write('namespace emu8086 {\n')
-    f.write('enum class InstructionOpcode {\n')
+    f.write('enum class InstructionOpcode : uint8_t {\n')
     f.write('\tUnknown = 0,\n')
 
     instr_names.remove("Unknown")
     instr_names = sorted(instr_names)
     for name in instr_names:
         f.write('\t{},\n'.format(name))
-    f.write('};\n')
+    f.write('};\n\n')
+
+    # Names are indexed by InstructionOpcode so the decoded instruction
+    # doesn't need to carry a string.
+    f.write('constexpr std::string_view instr_opcode_names[] = {\n')
+    f.write('\t"Unknown",\n')
+    for name in instr_names:
+        f.write('\t"{}",\n'.format(name.rstrip('_')))
+    f.write('};\n\n')
 
-    f.write('enum class InstructionType {\n')
+    f.write('enum class InstructionType : uint8_t {\n')
     f.write('\tUnknown = 0,\n')
     instr_types.remove('Unknown')
     instr_types = sorted(instr_types)
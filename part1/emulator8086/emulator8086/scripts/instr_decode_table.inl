@@ -0,0 +1,383 @@
+// DO NOT MODIFY!!! Automatically generated by generate_instruction_table.py.
+
+constexpr DecodeFn special_decode_table[12][8] = {
+   {
+       &decode_instr<0x80, InstructionType::Imm_RegMem_SE, InstructionOpcode::add>,
+       &decode_instr<0x80, InstructionType::Imm_RegMem, InstructionOpcode::or_>,
+       &decode_instr<0x80, InstructionType::Imm_RegMem_SE, InstructionOpcode::adc>,
+       &decode_instr<0x80, InstructionType::Imm_RegMem_SE, InstructionOpcode::sbb>,
+       &decode_instr<0x80, InstructionType::Imm_RegMem, InstructionOpcode::and_>,
+       &decode_instr<0x80, InstructionType::Imm_RegMem_SE, InstructionOpcode::sub>,
+       &decode_instr<0x80, InstructionType::Imm_RegMem, InstructionOpcode::xor_>,
+       &decode_instr<0x80, InstructionType::Imm_RegMem_SE, InstructionOpcode::cmp>,
+   },
+   {
+       &decode_instr<0x81, InstructionType::Imm_RegMem_SE, InstructionOpcode::add>,
+       &decode_instr<0x81, InstructionType::Imm_RegMem, InstructionOpcode::or_>,
+       &decode_instr<0x81, InstructionType::Imm_RegMem_SE, InstructionOpcode::adc>,
+       &decode_instr<0x81, InstructionType::Imm_RegMem_SE, InstructionOpcode::sbb>,
+       &decode_instr<0x81, InstructionType::Imm_RegMem, InstructionOpcode::and_>,
+       &decode_instr<0x81, InstructionType::Imm_RegMem_SE, InstructionOpcode::sub>,
+       &decode_instr<0x81, InstructionType::Imm_RegMem, InstructionOpcode::xor_>,
+       &decode_instr<0x81, InstructionType::Imm_RegMem_SE, InstructionOpcode::cmp>,
+   },
+   {
+       &decode_instr<0x82, InstructionType::Imm_RegMem_SE, InstructionOpcode::add>,
+       &decode_unknown,
+       &decode_instr<0x82, InstructionType::Imm_RegMem_SE, InstructionOpcode::adc>,
+       &decode_instr<0x82, InstructionType::Imm_RegMem_SE, InstructionOpcode::sbb>,
+       &decode_unknown,
+       &decode_instr<0x82, InstructionType::Imm_RegMem_SE, InstructionOpcode::sub>,
+       &decode_unknown,
+       &decode_instr<0x82, InstructionType::Imm_RegMem_SE, InstructionOpcode::cmp>,
+   },
+   {
+       &decode_instr<0x83, InstructionType::Imm_RegMem_SE, InstructionOpcode::add>,
+       &decode_unknown,
+       &decode_instr<0x83, InstructionType::Imm_RegMem_SE, InstructionOpcode::adc>,
+       &decode_instr<0x83, InstructionType::Imm_RegMem_SE, InstructionOpcode::sbb>,
+       &decode_unknown,
+       &decode_instr<0x83, InstructionType::Imm_RegMem_SE, InstructionOpcode::sub>,
+       &decode_unknown,
+       &decode_instr<0x83, InstructionType::Imm_RegMem_SE, InstructionOpcode::cmp>,
+   },
+   {
+       &decode_instr<0xD0, InstructionType::RegMem_1, InstructionOpcode::rol>,
+       &decode_instr<0xD0, InstructionType::RegMem_1, InstructionOpcode::ror>,
+       &decode_instr<0xD0, InstructionType::RegMem_1, InstructionOpcode::rcl>,
+       &decode_instr<0xD0, InstructionType::RegMem_1, InstructionOpcode::rcr>,
+       &decode_instr<0xD0, InstructionType::RegMem_1, InstructionOpcode::sal>,
+       &decode_instr<0xD0, InstructionType::RegMem_1, InstructionOpcode::shr>,
+       &decode_unknown,
+       &decode_instr<0xD0, InstructionType::RegMem_1, InstructionOpcode::sar>,
+   },
+   {
+       &decode_instr<0xD1, InstructionType::RegMem_1, InstructionOpcode::rol>,
+       &decode_instr<0xD1, InstructionType::RegMem_1, InstructionOpcode::ror>,
+       &decode_instr<0xD1, InstructionType::RegMem_1, InstructionOpcode::rcl>,
+       &decode_instr<0xD1, InstructionType::RegMem_1, InstructionOpcode::rcr>,
+       &decode_instr<0xD1, InstructionType::RegMem_1, InstructionOpcode::sal>,
+       &decode_instr<0xD1, InstructionType::RegMem_1, InstructionOpcode::shr>,
+       &decode_unknown,
+       &decode_instr<0xD1, InstructionType::RegMem_1, InstructionOpcode::sar>,
+   },
+   {
+       &decode_instr<0xD2, InstructionType::RegMem_CL, InstructionOpcode::rol>,
+       &decode_instr<0xD2, InstructionType::RegMem_CL, InstructionOpcode::ror>,
+       &decode_instr<0xD2, InstructionType::RegMem_CL, InstructionOpcode::rcl>,
+       &decode_instr<0xD2, InstructionType::RegMem_CL, InstructionOpcode::rcr>,
+       &decode_instr<0xD2, InstructionType::RegMem_CL, InstructionOpcode::sal>,
+       &decode_instr<0xD2, InstructionType::RegMem_CL, InstructionOpcode::shr>,
+       &decode_unknown,
+       &decode_instr<0xD2, InstructionType::RegMem_CL, InstructionOpcode::sar>,
+   },
+   {
+       &decode_instr<0xD3, InstructionType::RegMem_CL, InstructionOpcode::rol>,
+       &decode_instr<0xD3, InstructionType::RegMem_CL, InstructionOpcode::ror>,
+       &decode_instr<0xD3, InstructionType::RegMem_CL, InstructionOpcode::rcl>,
+       &decode_instr<0xD3, InstructionType::RegMem_CL, InstructionOpcode::rcr>,
+       &decode_instr<0xD3, InstructionType::RegMem_CL, InstructionOpcode::sal>,
+       &decode_instr<0xD3, InstructionType::RegMem_CL, InstructionOpcode::shr>,
+       &decode_unknown,
+       &decode_instr<0xD3, InstructionType::RegMem_CL, InstructionOpcode::sar>,
+   },
+   {
+       &decode_instr<0xF6, InstructionType::Imm_RegMem, InstructionOpcode::test>,
+       &decode_unknown,
+       &decode_instr<0xF6, InstructionType::RegMem, InstructionOpcode::not_>,
+       &decode_instr<0xF6, InstructionType::RegMem, InstructionOpcode::neg>,
+       &decode_instr<0xF6, InstructionType::RegMem, InstructionOpcode::mul>,
+       &decode_instr<0xF6, InstructionType::RegMem, InstructionOpcode::imul>,
+       &decode_instr<0xF6, InstructionType::RegMem, InstructionOpcode::div>,
+       &decode_instr<0xF6, InstructionType::RegMem, InstructionOpcode::idiv>,
+   },
+   {
+       &decode_instr<0xF7, InstructionType::Imm_RegMem, InstructionOpcode::test>,
+       &decode_unknown,
+       &decode_instr<0xF7, InstructionType::RegMem, InstructionOpcode::not_>,
+       &decode_instr<0xF7, InstructionType::RegMem, InstructionOpcode::neg>,
+       &decode_instr<0xF7, InstructionType::RegMem, InstructionOpcode::mul>,
+       &decode_instr<0xF7, InstructionType::RegMem, InstructionOpcode::imul>,
+       &decode_instr<0xF7, InstructionType::RegMem, InstructionOpcode::div>,
+       &decode_instr<0xF7, InstructionType::RegMem, InstructionOpcode::idiv>,
+   },
+   {
+       &decode_instr<0xFE, InstructionType::RegMem, InstructionOpcode::inc>,
+       &decode_instr<0xFE, InstructionType::RegMem, InstructionOpcode::dec>,
+       &decode_unknown,
+       &decode_unknown,
+       &decode_unknown,
+       &decode_unknown,
+       &decode_unknown,
+       &decode_unknown,
+   },
+   {
+       &decode_instr<0xFF, InstructionType::RegMem, InstructionOpcode::inc>,
+       &decode_instr<0xFF, InstructionType::RegMem, InstructionOpcode::dec>,
+       &decode_instr<0xFF, InstructionType::RegMem, InstructionOpcode::call>,
+       &decode_instr<0xFF, InstructionType::RegMem_Far, InstructionOpcode::call>,
+       &decode_instr<0xFF, InstructionType::RegMem, InstructionOpcode::jmp>,
+       &decode_instr<0xFF, InstructionType::RegMem_Far, InstructionOpcode::jmp>,
+       &decode_instr<0xFF, InstructionType::RegMem, InstructionOpcode::push>,
+       &decode_unknown,
+   },
+};
+
+constexpr DecodeFn decode_table[256] = {
+   &decode_instr<0x00, InstructionType::RegMem_Reg, InstructionOpcode::add>,
+   &decode_instr<0x01, InstructionType::RegMem_Reg, InstructionOpcode::add>,
+   &decode_instr<0x02, InstructionType::RegMem_Reg, InstructionOpcode::add>,
+   &decode_instr<0x03, InstructionType::RegMem_Reg, InstructionOpcode::add>,
+   &decode_instr<0x04, InstructionType::Imm_Acc, InstructionOpcode::add>,
+   &decode_instr<0x05, InstructionType::Imm_Acc, InstructionOpcode::add>,
+   &decode_instr<0x06, InstructionType::SR, InstructionOpcode::push>,
+   &decode_instr<0x07, InstructionType::SR, InstructionOpcode::pop>,
+   &decode_instr<0x08, InstructionType::RegMem_Reg, InstructionOpcode::or_>,
+   &decode_instr<0x09, InstructionType::RegMem_Reg, InstructionOpcode::or_>,
+   &decode_instr<0x0A, InstructionType::RegMem_Reg, InstructionOpcode::or_>,
+   &decode_instr<0x0B, InstructionType::RegMem_Reg, InstructionOpcode::or_>,
+   &decode_instr<0x0C, InstructionType::Imm_Acc, InstructionOpcode::or_>,
+   &decode_instr<0x0D, InstructionType::Imm_Acc, InstructionOpcode::or_>,
+   &decode_instr<0x0E, InstructionType::SR, InstructionOpcode::push>,
+   &decode_unknown,
+   &decode_instr<0x10, InstructionType::RegMem_Reg, InstructionOpcode::adc>,
+   &decode_instr<0x11, InstructionType::RegMem_Reg, InstructionOpcode::adc>,
+   &decode_instr<0x12, InstructionType::RegMem_Reg, InstructionOpcode::adc>,
+   &decode_instr<0x13, InstructionType::RegMem_Reg, InstructionOpcode::adc>,
+   &decode_instr<0x14, InstructionType::Imm_Acc, InstructionOpcode::adc>,
+   &decode_instr<0x15, InstructionType::Imm_Acc, InstructionOpcode::adc>,
+   &decode_instr<0x16, InstructionType::SR, InstructionOpcode::push>,
+   &decode_instr<0x17, InstructionType::SR, InstructionOpcode::pop>,
+   &decode_instr<0x18, InstructionType::RegMem_Reg, InstructionOpcode::sbb>,
+   &decode_instr<0x19, InstructionType::RegMem_Reg, InstructionOpcode::sbb>,
+   &decode_instr<0x1A, InstructionType::RegMem_Reg, InstructionOpcode::sbb>,
+   &decode_instr<0x1B, InstructionType::RegMem_Reg, InstructionOpcode::sbb>,
+   &decode_instr<0x1C, InstructionType::Imm_Acc, InstructionOpcode::sbb>,
+   &decode_instr<0x1D, InstructionType::Imm_Acc, InstructionOpcode::sbb>,
+   &decode_instr<0x1E, InstructionType::SR, InstructionOpcode::push>,
+   &decode_instr<0x1F, InstructionType::SR, InstructionOpcode::pop>,
+   &decode_instr<0x20, InstructionType::RegMem_Reg, InstructionOpcode::and_>,
+   &decode_instr<0x21, InstructionType::RegMem_Reg, InstructionOpcode::and_>,
+   &decode_instr<0x22, InstructionType::RegMem_Reg, InstructionOpcode::and_>,
+   &decode_instr<0x23, InstructionType::RegMem_Reg, InstructionOpcode::and_>,
+   &decode_instr<0x24, InstructionType::Imm_Acc, InstructionOpcode::and_>,
+   &decode_instr<0x25, InstructionType::Imm_Acc, InstructionOpcode::and_>,
+   &decode_instr<0x26, InstructionType::SegmentPrefix, InstructionOpcode::Unknown>,
+   &decode_instr<0x27, InstructionType::SingleByte, InstructionOpcode::daa>,
+   &decode_instr<0x28, InstructionType::RegMem_Reg, InstructionOpcode::sub>,
+   &decode_instr<0x29, InstructionType::RegMem_Reg, InstructionOpcode::sub>,
+   &decode_instr<0x2A, InstructionType::RegMem_Reg, InstructionOpcode::sub>,
+   &decode_instr<0x2B, InstructionType::RegMem_Reg, InstructionOpcode::sub>,
+   &decode_instr<0x2C, InstructionType::Imm_Acc, InstructionOpcode::sub>,
+   &decode_instr<0x2D, InstructionType::Imm_Acc, InstructionOpcode::sub>,
+   &decode_instr<0x2E, InstructionType::SegmentPrefix, InstructionOpcode::Unknown>,
+   &decode_instr<0x2F, InstructionType::SingleByte, InstructionOpcode::das>,
+   &decode_instr<0x30, InstructionType::RegMem_Reg, InstructionOpcode::xor_>,
+   &decode_instr<0x31, InstructionType::RegMem_Reg, InstructionOpcode::xor_>,
+   &decode_instr<0x32, InstructionType::RegMem_Reg, InstructionOpcode::xor_>,
+   &decode_instr<0x33, InstructionType::RegMem_Reg, InstructionOpcode::xor_>,
+   &decode_instr<0x34, InstructionType::Imm_Acc, InstructionOpcode::xor_>,
+   &decode_instr<0x35, InstructionType::Imm_Acc, InstructionOpcode::xor_>,
+   &decode_instr<0x36, InstructionType::SegmentPrefix, InstructionOpcode::Unknown>,
+   &decode_instr<0x37, InstructionType::SingleByte, InstructionOpcode::aaa>,
+   &decode_instr<0x38, InstructionType::RegMem_Reg, InstructionOpcode::cmp>,
+   &decode_instr<0x39, InstructionType::RegMem_Reg, InstructionOpcode::cmp>,
+   &decode_instr<0x3A, InstructionType::RegMem_Reg, InstructionOpcode::cmp>,
+   &decode_instr<0x3B, InstructionType::RegMem_Reg, InstructionOpcode::cmp>,
+   &decode_instr<0x3C, InstructionType::Imm_Acc, InstructionOpcode::cmp>,
+   &decode_instr<0x3D, InstructionType::Imm_Acc, InstructionOpcode::cmp>,
+   &decode_instr<0x3E, InstructionType::SegmentPrefix, InstructionOpcode::Unknown>,
+   &decode_instr<0x3F, InstructionType::SingleByte, InstructionOpcode::aas>,
+   &decode_instr<0x40, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x41, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x42, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x43, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x44, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x45, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x46, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x47, InstructionType::Reg, InstructionOpcode::inc>,
+   &decode_instr<0x48, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x49, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x4A, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x4B, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x4C, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x4D, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x4E, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x4F, InstructionType::Reg, InstructionOpcode::dec>,
+   &decode_instr<0x50, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x51, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x52, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x53, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x54, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x55, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x56, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x57, InstructionType::Reg, InstructionOpcode::push>,
+   &decode_instr<0x58, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_instr<0x59, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_instr<0x5A, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_instr<0x5B, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_instr<0x5C, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_instr<0x5D, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_instr<0x5E, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_instr<0x5F, InstructionType::Reg, InstructionOpcode::pop>,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_instr<0x70, InstructionType::Jmp, InstructionOpcode::jo>,
+   &decode_instr<0x71, InstructionType::Jmp, InstructionOpcode::jno>,
+   &decode_instr<0x72, InstructionType::Jmp, InstructionOpcode::jb>,
+   &decode_instr<0x73, InstructionType::Jmp, InstructionOpcode::jnb>,
+   &decode_instr<0x74, InstructionType::Jmp, InstructionOpcode::je>,
+   &decode_instr<0x75, InstructionType::Jmp, InstructionOpcode::jne>,
+   &decode_instr<0x76, InstructionType::Jmp, InstructionOpcode::jbe>,
+   &decode_instr<0x77, InstructionType::Jmp, InstructionOpcode::jnbe>,
+   &decode_instr<0x78, InstructionType::Jmp, InstructionOpcode::js>,
+   &decode_instr<0x79, InstructionType::Jmp, InstructionOpcode::jns>,
+   &decode_instr<0x7A, InstructionType::Jmp, InstructionOpcode::jp>,
+   &decode_instr<0x7B, InstructionType::Jmp, InstructionOpcode::jnp>,
+   &decode_instr<0x7C, InstructionType::Jmp, InstructionOpcode::jl>,
+   &decode_instr<0x7D, InstructionType::Jmp, InstructionOpcode::jnl>,
+   &decode_instr<0x7E, InstructionType::Jmp, InstructionOpcode::jle>,
+   &decode_instr<0x7F, InstructionType::Jmp, InstructionOpcode::jnle>,
+   &decode_special<0x80, 0>,
+   &decode_special<0x81, 1>,
+   &decode_special<0x82, 2>,
+   &decode_special<0x83, 3>,
+   &decode_instr<0x84, InstructionType::RegMem_Reg, InstructionOpcode::test>,
+   &decode_instr<0x85, InstructionType::RegMem_Reg, InstructionOpcode::test>,
+   &decode_instr<0x86, InstructionType::RegMem_Reg, InstructionOpcode::xchg>,
+   &decode_instr<0x87, InstructionType::RegMem_Reg, InstructionOpcode::xchg>,
+   &decode_instr<0x88, InstructionType::RegMem_Reg, InstructionOpcode::mov>,
+   &decode_instr<0x89, InstructionType::RegMem_Reg, InstructionOpcode::mov>,
+   &decode_instr<0x8A, InstructionType::RegMem_Reg, InstructionOpcode::mov>,
+   &decode_instr<0x8B, InstructionType::RegMem_Reg, InstructionOpcode::mov>,
+   &decode_instr<0x8C, InstructionType::SR_RegMem, InstructionOpcode::mov>,
+   &decode_instr<0x8D, InstructionType::Mem_Reg, InstructionOpcode::lea>,
+   &decode_instr<0x8E, InstructionType::SR_RegMem, InstructionOpcode::mov>,
+   &decode_instr<0x8F, InstructionType::RegMem, InstructionOpcode::pop>,
+   &decode_instr<0x90, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x91, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x92, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x93, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x94, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x95, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x96, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x97, InstructionType::Reg_Acc, InstructionOpcode::xchg>,
+   &decode_instr<0x98, InstructionType::SingleByte, InstructionOpcode::cbw>,
+   &decode_instr<0x99, InstructionType::SingleByte, InstructionOpcode::cwd>,
+   &decode_instr<0x9A, InstructionType::FarProc, InstructionOpcode::call>,
+   &decode_instr<0x9B, InstructionType::SingleByte, InstructionOpcode::wait>,
+   &decode_instr<0x9C, InstructionType::SingleByte, InstructionOpcode::pushf>,
+   &decode_instr<0x9D, InstructionType::SingleByte, InstructionOpcode::popf>,
+   &decode_instr<0x9E, InstructionType::SingleByte, InstructionOpcode::sahf>,
+   &decode_instr<0x9F, InstructionType::SingleByte, InstructionOpcode::lahf>,
+   &decode_instr<0xA0, InstructionType::Mem_Acc, InstructionOpcode::mov>,
+   &decode_instr<0xA1, InstructionType::Mem_Acc, InstructionOpcode::mov>,
+   &decode_instr<0xA2, InstructionType::Acc_Mem, InstructionOpcode::mov>,
+   &decode_instr<0xA3, InstructionType::Acc_Mem, InstructionOpcode::mov>,
+   &decode_instr<0xA4, InstructionType::StringManip, InstructionOpcode::movs>,
+   &decode_instr<0xA5, InstructionType::StringManip, InstructionOpcode::movs>,
+   &decode_instr<0xA6, InstructionType::StringManip, InstructionOpcode::cmps>,
+   &decode_instr<0xA7, InstructionType::StringManip, InstructionOpcode::cmps>,
+   &decode_instr<0xA8, InstructionType::Imm_Acc, InstructionOpcode::test>,
+   &decode_instr<0xA9, InstructionType::Imm_Acc, InstructionOpcode::test>,
+   &decode_instr<0xAA, InstructionType::StringManip, InstructionOpcode::stos>,
+   &decode_instr<0xAB, InstructionType::StringManip, InstructionOpcode::stos>,
+   &decode_instr<0xAC, InstructionType::StringManip, InstructionOpcode::lods>,
+   &decode_instr<0xAD, InstructionType::StringManip, InstructionOpcode::lods>,
+   &decode_instr<0xAE, InstructionType::StringManip, InstructionOpcode::scas>,
+   &decode_instr<0xAF, InstructionType::StringManip, InstructionOpcode::scas>,
+   &decode_instr<0xB0, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB1, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB2, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB3, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB4, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB5, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB6, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB7, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB8, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xB9, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xBA, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xBB, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xBC, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xBD, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xBE, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_instr<0xBF, InstructionType::Imm_Reg, InstructionOpcode::mov>,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_instr<0xC2, InstructionType::Imm16, InstructionOpcode::ret>,
+   &decode_instr<0xC3, InstructionType::SingleByte, InstructionOpcode::ret>,
+   &decode_instr<0xC4, InstructionType::Mem_Reg, InstructionOpcode::les>,
+   &decode_instr<0xC5, InstructionType::Mem_Reg, InstructionOpcode::lds>,
+   &decode_instr<0xC6, InstructionType::Imm_RegMem, InstructionOpcode::mov>,
+   &decode_instr<0xC7, InstructionType::Imm_RegMem, InstructionOpcode::mov>,
+   &decode_unknown,
+   &decode_unknown,
+   &decode_instr<0xCA, InstructionType::Imm16, InstructionOpcode::retf>,
+   &decode_instr<0xCB, InstructionType::SingleByte, InstructionOpcode::retf>,
+   &decode_instr<0xCC, InstructionType::SingleByte, InstructionOpcode::int3>,
+   &decode_instr<0xCD, InstructionType::Imm8, InstructionOpcode::int_>,
+   &decode_instr<0xCE, InstructionType::SingleByte, InstructionOpcode::into>,
+   &decode_instr<0xCF, InstructionType::SingleByte, InstructionOpcode::iret>,
+   &decode_special<0xD0, 4>,
+   &decode_special<0xD1, 5>,
+   &decode_special<0xD2, 6>,
+   &decode_special<0xD3, 7>,
+   &decode_instr<0xD4, InstructionType::SkipSecond, InstructionOpcode::aam>,
+   &decode_instr<0xD5, InstructionType::SkipSecond, InstructionOpcode::aad>,
+   &decode_unknown,
+   &decode_instr<0xD7, InstructionType::SingleByte, InstructionOpcode::xlat>,
+   &decode_instr<0xD8, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xD9, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xDA, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xDB, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xDC, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xDD, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xDE, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xDF, InstructionType::Esc, InstructionOpcode::esc>,
+   &decode_instr<0xE0, InstructionType::Jmp, InstructionOpcode::loopnz>,
+   &decode_instr<0xE1, InstructionType::Jmp, InstructionOpcode::loopz>,
+   &decode_instr<0xE2, InstructionType::Jmp, InstructionOpcode::loop>,
+   &decode_instr<0xE3, InstructionType::Jmp, InstructionOpcode::jcxz>,
+   &decode_instr<0xE4, InstructionType::FixedPort, InstructionOpcode::in>,
+   &decode_instr<0xE5, InstructionType::FixedPort, InstructionOpcode::in>,
+   &decode_instr<0xE6, InstructionType::FixedPort, InstructionOpcode::out>,
+   &decode_instr<0xE7, InstructionType::FixedPort, InstructionOpcode::out>,
+   &decode_instr<0xE8, InstructionType::NearProc, InstructionOpcode::call>,
+   &decode_instr<0xE9, InstructionType::NearProc, InstructionOpcode::jmp>,
+   &decode_instr<0xEA, InstructionType::FarProc, InstructionOpcode::jmp>,
+   &decode_instr<0xEB, InstructionType::Jmp, InstructionOpcode::jmp>,
+   &decode_instr<0xEC, InstructionType::VariablePort, InstructionOpcode::in>,
+   &decode_instr<0xED, InstructionType::VariablePort, InstructionOpcode::in>,
+   &decode_instr<0xEE, InstructionType::VariablePort, InstructionOpcode::out>,
+   &decode_instr<0xEF, InstructionType::VariablePort, InstructionOpcode::out>,
+   &decode_instr<0xF0, InstructionType::SingleByte, InstructionOpcode::lock>,
+   &decode_unknown,
+   &decode_instr<0xF2, InstructionType::SingleByte, InstructionOpcode::repne>,
+   &decode_instr<0xF3, InstructionType::SingleByte, InstructionOpcode::rep>,
+   &decode_instr<0xF4, InstructionType::SingleByte, InstructionOpcode::hlt>,
+   &decode_instr<0xF5, InstructionType::SingleByte, InstructionOpcode::cmc>,
+   &decode_special<0xF6, 8>,
+   &decode_special<0xF7, 9>,
+   &decode_instr<0xF8, InstructionType::SingleByte, InstructionOpcode::clc>,
+   &decode_instr<0xF9, InstructionType::SingleByte, InstructionOpcode::stc>,
+   &decode_instr<0xFA, InstructionType::SingleByte, InstructionOpcode::cli>,
+   &decode_instr<0xFB, InstructionType::SingleByte, InstructionOpcode::sti>,
+   &decode_instr<0xFC, InstructionType::SingleByte, InstructionOpcode::cld>,
+   &decode_instr<0xFD, InstructionType::SingleByte, InstructionOpcode::std>,
+   &decode_special<0xFE, 10>,
+   &decode_special<0xFF, 11>,
+};
@@ -0,0 +1,260 @@
+// DO NOT MODIFY!!! Automatically generated by generate_instruction_table.py.
+
+inline constexpr InstrLength instr_lengths[256] = {
+   { 2, LENGTH_MODRM }, // add
+   { 2, LENGTH_MODRM }, // add
+   { 2, LENGTH_MODRM }, // add
+   { 2, LENGTH_MODRM }, // add
+   { 2, 0 }, // add
+   { 3, 0 }, // add
+   { 1, 0 }, // push
+   { 1, 0 }, // pop
+   { 2, LENGTH_MODRM }, // or
+   { 2, LENGTH_MODRM }, // or
+   { 2, LENGTH_MODRM }, // or
+   { 2, LENGTH_MODRM }, // or
+   { 2, 0 }, // or
+   { 3, 0 }, // or
+   { 1, 0 }, // push
+   { 1, 0 }, // Unknown
+   { 2, LENGTH_MODRM }, // adc
+   { 2, LENGTH_MODRM }, // adc
+   { 2, LENGTH_MODRM }, // adc
+   { 2, LENGTH_MODRM }, // adc
+   { 2, 0 }, // adc
+   { 3, 0 }, // adc
+   { 1, 0 }, // push
+   { 1, 0 }, // pop
+   { 2, LENGTH_MODRM }, // sbb
+   { 2, LENGTH_MODRM }, // sbb
+   { 2, LENGTH_MODRM }, // sbb
+   { 2, LENGTH_MODRM }, // sbb
+   { 2, 0 }, // sbb
+   { 3, 0 }, // sbb
+   { 1, 0 }, // push
+   { 1, 0 }, // pop
+   { 2, LENGTH_MODRM }, // and
+   { 2, LENGTH_MODRM }, // and
+   { 2, LENGTH_MODRM }, // and
+   { 2, LENGTH_MODRM }, // and
+   { 2, 0 }, // and
+   { 3, 0 }, // and
+   { 1, LENGTH_PREFIX }, // -
+   { 1, 0 }, // daa
+   { 2, LENGTH_MODRM }, // sub
+   { 2, LENGTH_MODRM }, // sub
+   { 2, LENGTH_MODRM }, // sub
+   { 2, LENGTH_MODRM }, // sub
+   { 2, 0 }, // sub
+   { 3, 0 }, // sub
+   { 1, LENGTH_PREFIX }, // -
+   { 1, 0 }, // das
+   { 2, LENGTH_MODRM }, // xor
+   { 2, LENGTH_MODRM }, // xor
+   { 2, LENGTH_MODRM }, // xor
+   { 2, LENGTH_MODRM }, // xor
+   { 2, 0 }, // xor
+   { 3, 0 }, // xor
+   { 1, LENGTH_PREFIX }, // -
+   { 1, 0 }, // aaa
+   { 2, LENGTH_MODRM }, // cmp
+   { 2, LENGTH_MODRM }, // cmp
+   { 2, LENGTH_MODRM }, // cmp
+   { 2, LENGTH_MODRM }, // cmp
+   { 2, 0 }, // cmp
+   { 3, 0 }, // cmp
+   { 1, LENGTH_PREFIX }, // -
+   { 1, 0 }, // aas
+   { 1, 0 }, // inc
+   { 1, 0 }, // inc
+   { 1, 0 }, // inc
+   { 1, 0 }, // inc
+   { 1, 0 }, // inc
+   { 1, 0 }, // inc
+   { 1, 0 }, // inc
+   { 1, 0 }, // inc
+   { 1, 0 }, // dec
+   { 1, 0 }, // dec
+   { 1, 0 }, // dec
+   { 1, 0 }, // dec
+   { 1, 0 }, // dec
+   { 1, 0 }, // dec
+   { 1, 0 }, // dec
+   { 1, 0 }, // dec
+   { 1, 0 }, // push
+   { 1, 0 }, // push
+   { 1, 0 }, // push
+   { 1, 0 }, // push
+   { 1, 0 }, // push
+   { 1, 0 }, // push
+   { 1, 0 }, // push
+   { 1, 0 }, // push
+   { 1, 0 }, // pop
+   { 1, 0 }, // pop
+   { 1, 0 }, // pop
+   { 1, 0 }, // pop
+   { 1, 0 }, // pop
+   { 1, 0 }, // pop
+   { 1, 0 }, // pop
+   { 1, 0 }, // pop
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 2, 0 }, // jo
+   { 2, 0 }, // jno
+   { 2, 0 }, // jb
+   { 2, 0 }, // jnb
+   { 2, 0 }, // je
+   { 2, 0 }, // jne
+   { 2, 0 }, // jbe
+   { 2, 0 }, // jnbe
+   { 2, 0 }, // js
+   { 2, 0 }, // jns
+   { 2, 0 }, // jp
+   { 2, 0 }, // jnp
+   { 2, 0 }, // jl
+   { 2, 0 }, // jnl
+   { 2, 0 }, // jle
+   { 2, 0 }, // jnle
+   { 3, LENGTH_MODRM }, // -
+   { 4, LENGTH_MODRM }, // -
+   { 3, LENGTH_MODRM }, // -
+   { 3, LENGTH_MODRM }, // -
+   { 2, LENGTH_MODRM }, // test
+   { 2, LENGTH_MODRM }, // test
+   { 2, LENGTH_MODRM }, // xchg
+   { 2, LENGTH_MODRM }, // xchg
+   { 2, LENGTH_MODRM }, // mov
+   { 2, LENGTH_MODRM }, // mov
+   { 2, LENGTH_MODRM }, // mov
+   { 2, LENGTH_MODRM }, // mov
+   { 2, LENGTH_MODRM }, // mov
+   { 2, LENGTH_MODRM }, // lea
+   { 2, LENGTH_MODRM }, // mov
+   { 2, LENGTH_MODRM }, // pop
+   { 1, 0 }, // xchg
+   { 1, 0 }, // xchg
+   { 1, 0 }, // xchg
+   { 1, 0 }, // xchg
+   { 1, 0 }, // xchg
+   { 1, 0 }, // xchg
+   { 1, 0 }, // xchg
+   { 1, 0 }, // xchg
+   { 1, 0 }, // cbw
+   { 1, 0 }, // cwd
+   { 5, 0 }, // call
+   { 1, 0 }, // wait
+   { 1, 0 }, // pushf
+   { 1, 0 }, // popf
+   { 1, 0 }, // sahf
+   { 1, 0 }, // lahf
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 1, 0 }, // movs
+   { 1, 0 }, // movs
+   { 1, 0 }, // cmps
+   { 1, 0 }, // cmps
+   { 2, 0 }, // test
+   { 3, 0 }, // test
+   { 1, 0 }, // stos
+   { 1, 0 }, // stos
+   { 1, 0 }, // lods
+   { 1, 0 }, // lods
+   { 1, 0 }, // scas
+   { 1, 0 }, // scas
+   { 2, 0 }, // mov
+   { 2, 0 }, // mov
+   { 2, 0 }, // mov
+   { 2, 0 }, // mov
+   { 2, 0 }, // mov
+   { 2, 0 }, // mov
+   { 2, 0 }, // mov
+   { 2, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 3, 0 }, // mov
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 3, 0 }, // ret
+   { 1, 0 }, // ret
+   { 2, LENGTH_MODRM }, // les
+   { 2, LENGTH_MODRM }, // lds
+   { 3, LENGTH_MODRM }, // mov
+   { 4, LENGTH_MODRM }, // mov
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // Unknown
+   { 3, 0 }, // retf
+   { 1, 0 }, // retf
+   { 1, 0 }, // int3
+   { 2, 0 }, // int
+   { 1, 0 }, // into
+   { 1, 0 }, // iret
+   { 2, LENGTH_MODRM }, // -
+   { 2, LENGTH_MODRM }, // -
+   { 2, LENGTH_MODRM }, // -
+   { 2, LENGTH_MODRM }, // -
+   { 2, 0 }, // aam
+   { 2, 0 }, // aad
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // xlat
+   { 2, LENGTH_MODRM }, // esc
+   { 2, LENGTH_MODRM }, // esc
+   { 2, LENGTH_MODRM }, // esc
+   { 2, LENGTH_MODRM }, // esc
+   { 2, LENGTH_MODRM }, // esc
+   { 2, LENGTH_MODRM }, // esc
+   { 2, LENGTH_MODRM }, // esc
+   { 2, LENGTH_MODRM }, // esc
+   { 2, 0 }, // loopnz
+   { 2, 0 }, // loopz
+   { 2, 0 }, // loop
+   { 2, 0 }, // jcxz
+   { 2, 0 }, // in
+   { 2, 0 }, // in
+   { 2, 0 }, // out
+   { 2, 0 }, // out
+   { 3, 0 }, // call
+   { 3, 0 }, // jmp
+   { 5, 0 }, // jmp
+   { 2, 0 }, // jmp
+   { 1, 0 }, // in
+   { 1, 0 }, // in
+   { 1, 0 }, // out
+   { 1, 0 }, // out
+   { 1, LENGTH_PREFIX }, // lock
+   { 1, 0 }, // Unknown
+   { 1, 0 }, // repne
+   { 1, LENGTH_PREFIX }, // rep
+   { 1, 0 }, // hlt
+   { 1, 0 }, // cmc
+   { 2, uint8_t(LENGTH_MODRM | LENGTH_GROUP_IMM) }, // -
+   { 2, uint8_t(LENGTH_MODRM | LENGTH_GROUP_IMM) }, // -
+   { 1, 0 }, // clc
+   { 1, 0 }, // stc
+   { 1, 0 }, // cli
+   { 1, 0 }, // sti
+   { 1, 0 }, // cld
+   { 1, 0 }, // std
+   { 2, LENGTH_MODRM }, // -
+   { 2, LENGTH_MODRM }, // -
+};
@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string_view>
+
 namespace emu8086 {
-enum class InstructionOpcode {
+enum class InstructionOpcode : uint8_t {
 	Unknown = 0,
 	aaa,
 	aad,
@@ -98,7 +101,104 @@ enum class InstructionOpcode {
 	xlat,
 	xor_,
 };
-enum class InstructionType {
+
+constexpr std::string_view instr_opcode_names[] = {
+	"Unknown",
+	"aaa",
+	"aad",
+	"aam",
+	"aas",
+	"adc",
+	"add",
+	"and",
+	"call",
+	"cbw",
+	"clc",
+	"cld",
+	"cli",
+	"cmc",
+	"cmp",
+	"cmps",
+	"cwd",
+	"daa",
+	"das",
+	"dec",
+	"div",
+	"esc",
+	"hlt",
+	"idiv",
+	"imul",
+	"in",
+	"inc",
+	"int3",
+	"int",
+	"into",
+	"iret",
+	"jb",
+	"jbe",
+	"jcxz",
+	"je",
+	"jl",
+	"jle",
+	"jmp",
+	"jnb",
+	"jnbe",
+	"jne",
+	"jnl",
+	"jnle",
+	"jno",
+	"jnp",
+	"jns",
+	"jo",
+	"jp",
+	"js",
+	"lahf",
+	"lds",
+	"lea",
+	"les",
+	"lock",
+	"lods",
+	"loop",
+	"loopnz",
+	"loopz",
+	"mov",
+	"movs",
+	"mul",
+	"neg",
+	"not",
+	"or",
+	"out",
+	"pop",
+	"popf",
+	"push",
+	"pushf",
+	"rcl",
+	"rcr",
+	"rep",
+	"repne",
+	"ret",
+	"retf",
+	"rol",
+	"ror",
+	"sahf",
+	"sal",
+	"sar",
+	"sbb",
+	"scas",
+	"shr",
+	"stc",
+	"std",
+	"sti",
+	"stos",
+	"sub",
+	"test",
+	"wait",
+	"xchg",
+	"xlat",
+	"xor",
+};
+
+enum class InstructionType : uint8_t {
 	Unknown = 0,
 	Acc_Mem,
 	Esc,
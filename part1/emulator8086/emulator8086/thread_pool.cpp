@@ -0,0 +1,116 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace emu8086 {
+
+ThreadPool::ThreadPool(unsigned thread_count) {
+	if (thread_count == 0) {
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for (unsigned i = 0; i < thread_count; ++i) {
+		queues.push_back(std::make_unique<Queue>());
+	}
+
+	for (unsigned i = 0; i < thread_count; ++i) {
+		threads.emplace_back([this, i]() { run(i); });
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard lock(mutex);
+		stop = true;
+	}
+	work_cv.notify_all();
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+}
+
+unsigned ThreadPool::size() const {
+	return static_cast<unsigned>(threads.size());
+}
+
+void ThreadPool::submit(Task task) {
+	unsigned idx = 0;
+	{
+		std::lock_guard lock(mutex);
+		++pending;
+		idx = next_queue;
+		next_queue = (next_queue + 1) % queues.size();
+	}
+
+	{
+		Queue &queue = *queues[idx];
+		std::lock_guard lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+		++queued;
+	}
+
+	// Sync with a worker that is between its predicate check and going to sleep.
+	{ std::lock_guard lock(mutex); }
+	work_cv.notify_one();
+}
+
+void ThreadPool::wait() {
+	std::unique_lock lock(mutex);
+	done_cv.wait(lock, [this]() { return pending == 0; });
+}
+
+bool ThreadPool::pop(unsigned idx, Task &task) {
+	Queue &queue = *queues[idx];
+	std::lock_guard lock(queue.mutex);
+	if (queue.tasks.empty()) {
+		return false;
+	}
+
+	task = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	--queued;
+
+	return true;
+}
+
+bool ThreadPool::steal(unsigned idx, Task &task) {
+	for (std::size_t i = 1; i < queues.size(); ++i) {
+		Queue &queue = *queues[(idx + i) % queues.size()];
+		std::lock_guard lock(queue.mutex);
+		if (queue.tasks.empty()) {
+			continue;
+		}
+
+		task = std::move(queue.tasks.front());
+		queue.tasks.pop_front();
+		--queued;
+
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::run(unsigned idx) {
+	while (true) {
+		Task task;
+		if (pop(idx, task) || steal(idx, task)) {
+			task();
+
+			std::lock_guard lock(mutex);
+			if (--pending == 0) {
+				done_cv.notify_all();
+			}
+			continue;
+		}
+
+		std::unique_lock lock(mutex);
+		work_cv.wait(lock, [this]() { return stop || queued > 0; });
+		if (stop && queued == 0) {
+			return;
+		}
+	}
+}
+
+} // namespace emu8086
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "emu8086.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace emu8086 {
+
+/**
+ * Work-stealing thread pool. Every worker has its own task queue and
+ * takes work from the back of it. Idle workers steal from the front
+ * of the other queues so a few long tasks don't hold up the rest.
+ */
+class ThreadPool {
+public:
+	using Task = std::function<void()>;
+
+	/**
+	 * 0 threads means one per hardware thread.
+	 */
+	explicit ThreadPool(unsigned thread_count = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	void submit(Task task);
+
+	/**
+	 * Blocks until every submitted task has finished.
+	 */
+	void wait();
+
+	unsigned size() const;
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	bool pop(unsigned idx, Task &task);
+	bool steal(unsigned idx, Task &task);
+	void run(unsigned idx);
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> threads;
+
+	std::mutex mutex;
+	std::condition_variable work_cv;
+	std::condition_variable done_cv;
+	std::atomic<std::size_t> queued = 0; // submitted but not yet taken
+	std::size_t pending = 0; // submitted but not yet finished, guarded by mutex
+	unsigned next_queue = 0;
+	bool stop = false;
+};
+
+} // namespace emu8086
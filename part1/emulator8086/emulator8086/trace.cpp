@@ -0,0 +1,35 @@
+#include "trace.h"
+
+#include "decoder.h"
+
+namespace emu8086 {
+
+void TextTrace::instruction(const Instruction &instr, uint16_t ip, uint8_t length) {
+	print_instr(instr, ip, length);
+	fprintf(STREAM_OUT, " ; ");
+	print_flags();
+	fprintf(STREAM_OUT, "\n");
+}
+
+void print_trace_state(const TraceState &state, FILE *out) {
+	static constexpr int idxs[8] = { 0, 3, 1, 2, 4, 5, 6, 7 };
+
+	print_instr(state.instr, state.ip, state.length, out);
+	fprintf(out, " ;");
+	for (int i = 0; i < 8; ++i) {
+		fprintf(out, " %s:%04x", reg_to_str[idxs[i] + 8].data(), state.registers[idxs[i]]);
+	}
+	for (int i = 0; i < 4; ++i) {
+		fprintf(out, " %s:%04x", sr_to_str[i].data(), state.seg_regs[i]);
+	}
+	fprintf(out, " flags:");
+	const auto f = static_cast<uint16_t>(state.flags);
+	for (int i = 15; i >= 0; --i) {
+		if (f & (1 << i)) {
+			fprintf(out, " %s", flag_name[i]);
+		}
+	}
+	fprintf(out, "\n");
+}
+
+} // namespace emu8086
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "emu8086.h"
+#include "instructions.h"
+#include "memory.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace emu8086 {
+
+/**
+ * Trace policies are passed to emulate(), which calls instruction() after every executed instruction
+ * with the ip it started at.
+ */
+
+enum class TraceMode {
+	None,
+	Count,
+	Ring, // last RingTrace states, printed when execution stops
+	Text, // every instruction and the flags after it
+};
+
+/**
+ * Nothing is traced, the call compiles away.
+ */
+struct NoTrace {
+	void instruction(const Instruction &, uint16_t, uint8_t) {}
+};
+
+struct CountTrace {
+	void instruction(const Instruction &, uint16_t, uint8_t) { ++count; }
+
+	uint64_t count = 0;
+};
+
+struct TextTrace {
+	void instruction(const Instruction &instr, uint16_t ip, uint8_t length);
+};
+
+/**
+ * Machine state right after an instruction ran
+ */
+struct TraceState {
+	Instruction instr;
+	uint16_t ip; // of the instruction
+	uint8_t length;
+	Flag flags;
+	uint16_t registers[8];
+	SegmentRegister seg_regs[4];
+};
+
+void print_trace_state(const TraceState &state, FILE *out = STREAM_OUT);
+
+/**
+ * Keeps the states after the last N instructions.
+ */
+template <std::size_t N = 64>
+class RingTrace {
+public:
+	void instruction(const Instruction &instr, uint16_t ip, uint8_t length) {
+		TraceState &state = states[count++ % N];
+		state.instr = instr;
+		state.ip = ip;
+		state.length = length;
+		state.flags = current_flags();
+		const Register *regs = get_registers();
+		for (int i = 0; i < 8; ++i) {
+			state.registers[i] = regs[i].data;
+		}
+		const SegmentRegister *srs = get_srs();
+		for (int i = 0; i < 4; ++i) {
+			state.seg_regs[i] = srs[i];
+		}
+	}
+
+	/**
+	 * @breif Prints the kept states, oldest first.
+	 */
+	void print(FILE *out = STREAM_OUT) const {
+		for (uint64_t i = count > N ? count - N : 0; i < count; ++i) {
+			print_trace_state(states[i % N], out);
+		}
+	}
+
+private:
+	TraceState states[N];
+	uint64_t count = 0;
+};
+
+} // namespace emu8086